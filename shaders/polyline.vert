@@ -3,14 +3,18 @@
 uniform mat4 transform;
 uniform int num_attributes;
 uniform vec2 to_range;
-
-layout(location = 0) in float in_id;
-layout(location = 1) in float in_attribute;
+uniform bool quantized;
+uniform int row_words;
+uniform bool paged;
+uniform int block_rows;
+uniform bool highlight;
+uniform vec4 highlight_color;
 
 layout(location = 0) out vec4 vs_color;
 
+// raw float bits, or packed 8/16 bit values if quantized
 layout(std430, binding = 0) buffer dataBuffer {
-	float values[];
+	uint values[];
 };
 
 layout(std430, binding = 1) buffer colorBuffer {
@@ -25,19 +29,55 @@ layout(std430, binding = 3) buffer attributeBuffer {
 	float attribute_coords[];
 };
 
+struct QuantizedAttribute {
+	vec2 dequant;
+	uint bit_offset;
+	uint bits;
+};
+
+layout(std430, binding = 5) buffer quantizationBuffer {
+	QuantizedAttribute quantization[];
+};
+
+// pool slot of every row block if data is paged, -1 if not resident
+layout(std430, binding = 8) buffer blockBuffer {
+	int block_slots[];
+};
+
 
 float remap(float value, vec2 from, vec2 to) {
 	return to.x + (value - from.x) * (to.y - to.x) / (from.y - from.x);
 }
 
+// value of attribute in given data row, normed to to_range
+float fetch(int row, int attribute, int row_values) {
+	if (paged) {
+		// rows of evicted blocks collapse to NaN and aren't rasterized
+		int slot = block_slots[row / block_rows];
+		if (slot < 0) {
+			return uintBitsToFloat(0x7fc00000u);
+		}
+		row = slot * block_rows + row % block_rows;
+	}
+	if (!quantized) {
+		return remap(uintBitsToFloat(values[row * row_values + attribute]), ranges[attribute], to_range);
+	}
+	
+	QuantizedAttribute q = quantization[attribute];
+	uint word = values[row * row_words + int(q.bit_offset / 32)];
+	uint value = bitfieldExtract(word, int(q.bit_offset % 32), int(q.bits));
+	return fma(float(value), q.dequant.x, q.dequant.y);
+}
+
 void main() {
-	int _dataIndex = int(num_attributes) * int(in_id) + int(in_attribute);
-	float _value = values[_dataIndex];
-	float _norm = remap(_value, ranges[int(in_attribute)], to_range);
+	// no vertex buffer, indices address value (line, attribute) as line * num_attributes + attribute
+	int _id = gl_VertexID / num_attributes;
+	int _attribute = gl_VertexID % num_attributes;
+	float _norm = fetch(_id, _attribute, num_attributes);
 	
-	gl_Position = transform * vec4(vec2(attribute_coords[int(in_attribute)], _norm), 0.0, 1.0);
+	gl_Position = transform * vec4(vec2(attribute_coords[_attribute], _norm), 0.0, 1.0);
 	// gl_Position.z = _dataIndex;
 	
-	// pass-through color
-	vs_color = colors[int(in_id)];
+	// pass-through color, selected lines are drawn as highlight layer
+	vs_color = highlight ? highlight_color : colors[_id];
 }
@@ -1,25 +1,30 @@
 #version 450 core
 
-uniform mat4 transform;
 uniform mat4 view;
 uniform mat4 projection;
 
 uniform int num_data;
 uniform int num_attrib;
 uniform int num_times;
-uniform int attribute_idx;
+uniform int time_first; // first visible time step
+uniform int time_count; // number of visible time steps
 uniform vec2 to_range;
+uniform bool quantized;
+uniform int row_words;
+uniform bool paged;
+uniform int block_rows;
 
-layout(location = 0) in float in_id;
-layout(location = 1) in float in_time;
+// base instance of the indirect command, set through an instanced attribute
+layout(location = 0) in int draw_id;
 
 layout(location = 0) out vec4 vs_color;
 layout(location = 4) out float vs_range;
 layout(location = 5) out mat4 vs_model;
 
 
+// raw float bits, or packed 8/16 bit values if quantized
 layout(std430, binding = 0) buffer dataBuffer {
-	float values[];
+	uint values[];
 };
 
 layout(std430, binding = 1) buffer colorBuffer {
@@ -34,8 +39,47 @@ layout(std430, binding = 3) buffer attributeBuffer {
 	float attribute_coords[];
 };
 
-layout(std430, binding = 4) buffer timeBuffer {
-	float time_coords[];
+
+struct QuantizedAttribute {
+	vec2 dequant;
+	uint bit_offset;
+	uint bits;
+};
+
+layout(std430, binding = 5) buffer quantizationBuffer {
+	QuantizedAttribute quantization[];
+};
+
+// pool slot of every row block if data is paged, -1 if not resident
+layout(std430, binding = 8) buffer blockBuffer {
+	int block_slots[];
+};
+
+// one entry per drawn expansion side, mirrors TimeSeriesSide
+struct SideParameters {
+	mat4 transform;
+	int attribute_idx;
+	int pyramid_level; // 0 -> raw samples
+	int pyramid_offset; // first bucket of level
+	int pyramid_buckets; // buckets per line and attribute
+	int bucket_size; // time steps per bucket
+	int bucket_first; // first visible bucket
+	int bucket_count; // number of visible buckets
+	int vertex_count;
+};
+
+layout(std430, binding = 7) buffer sideBuffer {
+	SideParameters sides[];
+};
+
+// first, min & max in temporal order, last of every bucket, mirrors PyramidBucket
+struct Bucket {
+	vec4 values;
+	vec4 times; // time step of each value
+};
+
+layout(std430, binding = 6) buffer pyramidBuffer {
+	Bucket buckets[];
 };
 
 
@@ -43,24 +87,72 @@ float remap(float value, vec2 from, vec2 to) {
 	return to.x + (value - from.x) * (to.y - to.x) / (from.y - from.x);
 }
 
+// value of attribute in given data row, normed to to_range
+float fetch(int row, int attribute, int row_values) {
+	if (paged) {
+		// rows of evicted blocks collapse to NaN and aren't rasterized
+		int slot = block_slots[row / block_rows];
+		if (slot < 0) {
+			return uintBitsToFloat(0x7fc00000u);
+		}
+		row = slot * block_rows + row % block_rows;
+	}
+	if (!quantized) {
+		return remap(uintBitsToFloat(values[row * row_values + attribute]), ranges[attribute], to_range);
+	}
+	
+	QuantizedAttribute q = quantization[attribute];
+	uint word = values[row * row_words + int(q.bit_offset / 32)];
+	uint value = bitfieldExtract(word, int(q.bit_offset % 32), int(q.bits));
+	return fma(float(value), q.dequant.x, q.dequant.y);
+}
+
 void main() {
-	// get data value
-	int _dataIndex = int(num_data) * int(in_time) + int(in_id) * num_attrib + attribute_idx;
-	float _value = values[_dataIndex];
+	SideParameters side = sides[draw_id];
+	int _segment = gl_VertexID / 2;
+	int _id;
+	float _time_coord;
+	float _norm;
 	
-	// norm value according to scale
-	float _norm = remap(_value, ranges[attribute_idx], to_range);
+	if (side.pyramid_level == 0) {
+		// geometry is generated from the vertex id, two vertices per time segment 
+		// and (time_count - 1) segments per line
+		_id = _segment / (time_count - 1);
+		int _step = _segment % (time_count - 1) + gl_VertexID % 2;
+		int _time = time_first + _step;
+		_time_coord = float(_step) / (time_count - 1);
+
+		// get data value normed according to scale, time steps are stored one after another
+		int _row = (num_data / num_attrib) * _time + _id;
+		_norm = fetch(_row, side.attribute_idx, num_attrib);
+	}
+	else {
+		// four points per bucket, each at the time step it was sampled at. The tail bucket 
+		// only covers the remaining time steps and ends at the last one
+		int _points = side.bucket_count * 4;
+		_id = _segment / (_points - 1);
+		int _point = _segment % (_points - 1) + gl_VertexID % 2;
+		int _bucket = side.bucket_first + _point / 4;
+		int _corner = _point % 4;
+
+		Bucket _item = buckets[side.pyramid_offset + (_id * num_attrib + side.attribute_idx) * side.pyramid_buckets + _bucket];
+		float _time = _item.times[_corner];
+		_norm = remap(_item.values[_corner], ranges[side.attribute_idx], to_range);
+
+		// buckets at the window edges may reach past it, those points are pinned to the edge
+		_time_coord = clamp((_time - time_first) / (time_count - 1), 0.0, 1.0);
+	}
 	
-	gl_Position = vec4(time_coords[int(in_time)], _norm, 0, 1.0);
+	gl_Position = vec4(_time_coord, _norm, 0, 1.0);
 	
 	
 	// pass-through depth scaling
-	float depth_val = remap((1 - in_time / (num_attrib - 1)), vec2(0, 1), vec2(0.125, 1));
+	float depth_val = remap((1 - _time_coord), vec2(0, 1), vec2(0.125, 1));
 	vs_range = depth_val;
 
 	// pass-through color
-	vs_color = colors[int(in_id)];
+	vs_color = colors[_id];
 	
 	// pass-through model matrix
-	vs_model = transform;
+	vs_model = side.transform;
 }
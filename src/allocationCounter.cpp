@@ -0,0 +1,55 @@
+#include <allocationCounter.hpp>
+
+#ifdef COUNT_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> s_allocations{0};
+
+void* operator new(std::size_t size) {
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+#endif
+
+namespace AllocationCounter {
+    bool enabled() {
+#ifdef COUNT_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    size_t count() {
+#ifdef COUNT_ALLOCATIONS
+        return s_allocations.load(std::memory_order_relaxed);
+#else
+        return 0;
+#endif
+    }
+}
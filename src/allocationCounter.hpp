@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Counts heap allocations of the whole program, used to keep the interaction
+ * path allocation free. Only active if built with COUNT_ALLOCATIONS since 
+ * it replaces the global operator new.
+**/
+namespace AllocationCounter {
+    bool enabled();
+    size_t count(); // allocations since program start
+}
@@ -1,6 +1,7 @@
 #include <application.hpp>
 
-Application::Application() : m_clear_color{0.0f}, m_mouse_pos{-1.0, -1.0} {
+Application::Application(bool headless) 
+    : m_clear_color{0.0f}, m_mouse_pos{-1.0, -1.0}, m_input_time{std::chrono::system_clock::now()}, m_input_frame{0} {
 #ifdef NDEBUG
   spdlog::set_level(spdlog::level::info);
 #else
@@ -11,7 +12,7 @@ Application::Application() : m_clear_color{0.0f}, m_mouse_pos{-1.0, -1.0} {
     throw std::runtime_error("Failed to initialize GLFW!");
   }
 
-  if (!create_window()) {
+  if (!create_window(headless)) {
     throw std::runtime_error("Failed to create window!");
   }
 
@@ -58,16 +59,112 @@ void Application::update_mouse_pos(double x, double y) {
   m_mouse_pos = glm::dvec2{x, y};
 }
 
+GLFWwindow* Application::create_shared_context() const {
+  // has to be called on the main thread, may be made current on any other one
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+  GLFWwindow* context = glfwCreateWindow(1, 1, "loader", nullptr, m_window);
+  glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+
+  if (!context) {
+    throw std::runtime_error("Failed to create shared context!");
+  }
+  return context;
+}
+
+void Application::record_input(const std::string& path) {
+  m_recorder = std::make_unique<InputRecorder>(path);
+}
+
+void Application::replay_input(const std::string& path) {
+  m_replay = std::make_unique<InputReplay>(path);
+  m_replay_start = std::chrono::system_clock::now();
+}
+
 void Application::run() {
   while (!should_close()) {
+    auto start = std::chrono::steady_clock::now();
     update();
     draw();
     glfwSwapBuffers(m_window);
+    gl::CallCounter::instance().end_frame();
+
+    if (m_replay && input_ready()) {
+      // frame time includes the gpu work of the frame
+      glFinish();
+      m_replay->finishFrame(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                            gl::CallCounter::instance().frame());
+      if (m_replay->done() && idle()) {
+        set_should_close(true);
+      }
+    }
+    if (input_ready()) {
+      m_input_frame++;
+    }
+  }
+
+  if (m_replay) {
+    m_replay->report();
   }
 }
 
 bool Application::update() {
   glfwPollEvents();
+
+  // recorded events of this frame, the same frame they were polled on while recording
+  if (m_replay && input_ready()) {
+    m_replay->dispatch(m_input_frame, [this](const InputEvent& event) {
+      m_input_time = m_replay_start + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        std::chrono::duration<double, std::milli>(event.time));
+      apply_input(event);
+    });
+  }
+  return true;
+}
+
+void Application::handle_input(InputEvent event) {
+  // live input would make the replay nondeterministic
+  if (m_replay) {
+    return;
+  }
+  m_input_time = std::chrono::system_clock::now();
+  apply_input(event);
+  if (m_recorder) {
+    m_recorder->record(event, m_input_frame);
+  }
+}
+
+void Application::apply_input(const InputEvent& event) {
+  switch (event.type) {
+    case InputType::KEY:
+      on_key(event.key, event.scancode, event.action, event.mods);
+      break;
+    case InputType::BUTTON:
+      on_mouse_button(event.button, event.action, event.mods);
+      break;
+    case InputType::MOVE: {
+      const auto prev_pos = mouse_pos();
+      const auto new_pos = glm::dvec2{event.x * m_resolution.x, event.y * m_resolution.y};
+      double dx = 0.0;
+      double dy = 0.0;
+      if (prev_pos.x >= 0 && prev_pos.y >= 0) {
+        dx = new_pos.x - prev_pos.x;
+        dy = new_pos.y - prev_pos.y;
+      }
+      update_mouse_pos(new_pos.x, new_pos.y);
+      on_mouse_move(dx, dy);
+      break;
+    }
+    case InputType::SCROLL:
+      on_scroll(event.x, event.y);
+      break;
+  }
+}
+
+bool Application::input_ready() const {
+  return true;
+}
+
+bool Application::idle() const {
   return true;
 }
 
@@ -142,22 +239,32 @@ bool Application::init_glfw() {
     return true;
 }
 
-bool Application::create_window() {
-  GLFWmonitor* monitor = glfwGetPrimaryMonitor();
-  auto monitor_name = std::string{glfwGetMonitorName(monitor)};
-  spdlog::info("Using monitor '{}'", monitor_name);
-
-  // create a fullscreen window on the selected monitor
-  auto mode = glfwGetVideoMode(monitor);
-  m_window = glfwCreateWindow(mode->width, mode->height, "gl-vis-playground", monitor, nullptr);
-
-  // store the screen size
-  int width_mm, height_mm;
-  glfwGetMonitorPhysicalSize(monitor, &width_mm, &height_mm);
-  m_screen_size = glm::vec2{width_mm, height_mm} / 1000.0f;  // convert from mm to m
-
-  // store the window dimensions
-  m_resolution = glm::uvec2{mode->width, mode->height};
+bool Application::create_window(bool headless) {
+  if (headless) {
+    // hidden window of fixed size, no monitor needed
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    m_window = glfwCreateWindow(HEADLESS_WIDTH, HEADLESS_HEIGHT, "gl-vis-playground", nullptr, nullptr);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    m_screen_size = glm::vec2{0.5f, 0.28f};
+    m_resolution = glm::uvec2{HEADLESS_WIDTH, HEADLESS_HEIGHT};
+  }
+  else {
+    GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+    auto monitor_name = std::string{glfwGetMonitorName(monitor)};
+    spdlog::info("Using monitor '{}'", monitor_name);
+
+    // create a fullscreen window on the selected monitor
+    auto mode = glfwGetVideoMode(monitor);
+    m_window = glfwCreateWindow(mode->width, mode->height, "gl-vis-playground", monitor, nullptr);
+
+    // store the screen size
+    int width_mm, height_mm;
+    glfwGetMonitorPhysicalSize(monitor, &width_mm, &height_mm);
+    m_screen_size = glm::vec2{width_mm, height_mm} / 1000.0f;  // convert from mm to m
+
+    // store the window dimensions
+    m_resolution = glm::uvec2{mode->width, mode->height};
+  }
 
   if (!m_window) {
     spdlog::error("Failed to create GLFW window!");
@@ -166,6 +273,11 @@ bool Application::create_window() {
 
   glfwMakeContextCurrent(m_window);
 
+  // frames of a hidden window aren't presented, don't wait for vsync
+  if (headless) {
+    glfwSwapInterval(0);
+  }
+
   // set this class as user pointer to access it in callbacks
   glfwSetWindowUserPointer(m_window, this);
 
@@ -184,34 +296,27 @@ bool Application::create_window() {
   // keyboard callback
   glfwSetKeyCallback(m_window, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
     auto app = static_cast<Application*>(glfwGetWindowUserPointer(window));
-    app->on_key(key, scancode, action, mods);
+    app->handle_input(InputEvent{0, 0.0f, InputType::KEY, uint8_t(action), uint8_t(mods), 0, int16_t(key), int16_t(scancode), 0.0f, 0.0f});
   });
 
   // mouse cursor pos callback
   glfwSetCursorPosCallback(m_window, [](GLFWwindow* window, double x, double y) {
     auto app = static_cast<Application*>(glfwGetWindowUserPointer(window));
-    const auto prev_pos = app->mouse_pos();
-    const auto new_pos = glm::dvec2{x, app->resolution().y - y};
-    double dx = 0.0;
-    double dy = 0.0;
-    if (prev_pos.x >= 0 && prev_pos.y >= 0) {
-      dx = new_pos.x - prev_pos.x;
-      dy = new_pos.y - prev_pos.y;
-    }
-    app->update_mouse_pos(new_pos.x, new_pos.y);
-    app->on_mouse_move(dx, dy);
+    const auto resolution = glm::vec2(app->resolution());
+    const auto pos = glm::vec2{float(x) / resolution.x, 1.0f - float(y) / resolution.y};
+    app->handle_input(InputEvent{0, 0.0f, InputType::MOVE, 0, 0, 0, 0, 0, pos.x, pos.y});
   });
 
   // mouse button callback
   glfwSetMouseButtonCallback(m_window, [](GLFWwindow* window, int button, int action, int mods) {
     auto app = static_cast<Application*>(glfwGetWindowUserPointer(window));
-    app->on_mouse_button(button, action, mods);
+    app->handle_input(InputEvent{0, 0.0f, InputType::BUTTON, uint8_t(action), uint8_t(mods), uint8_t(button), 0, 0, 0.0f, 0.0f});
   });
 
   // scroll callback
   glfwSetScrollCallback(m_window, [](GLFWwindow* window, double x, double y) {
     auto app = static_cast<Application*>(glfwGetWindowUserPointer(window));
-    app->on_scroll(x, y);
+    app->handle_input(InputEvent{0, 0.0f, InputType::SCROLL, 0, 0, 0, 0, 0, float(x), float(y)});
   });
 
   return true;
@@ -228,6 +333,9 @@ bool Application::init_opengl() {
   glDebugMessageCallback(debugMessageCallback, 0);
 #endif
 
+  // per frame gl call counts, see gl::CallCounter
+  gl::CallCounter::instance().install();
+
   return true;
 }
 
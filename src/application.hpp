@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <set>
 #include <string>
@@ -13,13 +14,15 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <gl/call_counter.hpp>
 #include <gl/program.hpp>
 #include <gl/shader.hpp>
+#include <inputRecorder.hpp>
 #include <utils.hpp>
 
 class Application {
  public:
-  Application();
+  Application(bool headless = false);
   Application(const Application&) = delete;
   Application(Application&&) = default;
   virtual ~Application();
@@ -40,6 +43,25 @@ class Application {
 
   void update_mouse_pos(double x, double y);
 
+  // hidden window sharing all gl objects with the main one, for loader threads
+  GLFWwindow* create_shared_context() const;
+
+  // log input events to a file, or feed the events of one instead of live input
+  void record_input(const std::string& path);
+  void replay_input(const std::string& path);
+
+  // runs f, replays report its cpu time per step
+  template <typename F>
+  void timed(const char* section, F&& f) const {
+    if (!m_replay) {
+      f();
+      return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    f();
+    m_replay->measure(section, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+  }
+
   virtual void run();
   virtual bool update();
   virtual bool draw() const;
@@ -51,9 +73,20 @@ class Application {
   virtual void on_mouse_button(int button, int action, int mods);
   virtual void on_scroll(double x, double y);
 
+  // every glfw input event passes here, live or replayed
+  void handle_input(InputEvent event);
+
  protected:
+  static const int HEADLESS_WIDTH = 1920;
+  static const int HEADLESS_HEIGHT = 1080;
+
+  // input frames only count once the app takes input, replays end once it is idle
+  virtual bool input_ready() const;
+  virtual bool idle() const;
+  void apply_input(const InputEvent& event);
+
   bool init_glfw();
-  bool create_window();
+  bool create_window(bool headless);
   bool init_opengl();
   void poll_touch_events();
 
@@ -65,6 +98,13 @@ class Application {
   glm::uvec2 m_resolution;
   glm::dvec2 m_mouse_pos;
   bool m_mouse_buttons[3] = {false, false, false};
+
+  // input
+  std::chrono::time_point<std::chrono::system_clock> m_input_time; // time of the latest input event
+  uint32_t m_input_frame;
+  std::unique_ptr<InputRecorder> m_recorder;
+  std::unique_ptr<InputReplay> m_replay;
+  std::chrono::time_point<std::chrono::system_clock> m_replay_start;
 };
 
 void GLAPIENTRY debugMessageCallback(GLenum source,
@@ -0,0 +1,221 @@
+#include <axisBrush.hpp>
+
+AxisBrush::AxisBrush(GraphApp* app) :
+    Tool{app},
+    m_active{-1},
+    m_color{0.639, 0.670, 0.741, 0.8}
+{
+    m_program = m_linkedApp->getProgramLibrary()->program({"shaders/selection_rect.vert", "shaders/selection_rect.frag"});
+    
+    // model relative to screen space
+    m_mouse_model = glm::scale(glm::mat4{1.0f}, glm::vec3{
+        1.0f / m_linkedApp->getModel()[0][0], 
+        1.0f / m_linkedApp->getModel()[1][1], 
+        1.0f / m_linkedApp->getModel()[2][2]}
+    );
+    
+    // one rectangle per attribute at most
+    size_t num_axis = m_linkedApp->getAxis()->size();
+    m_brushes.reserve(num_axis);
+    m_vertices.reserve(num_axis * 4);
+    
+    m_vao = gl::VertexArray{"AxisBrush"};
+    GLuint pos_attrib_idx = 0;
+    glEnableVertexArrayAttrib(m_vao.id(), pos_attrib_idx);
+    glVertexArrayAttribFormat(m_vao.id(), pos_attrib_idx, 2, GL_FLOAT, false, offsetof(Point, pos));
+    glVertexArrayAttribBinding(m_vao.id(), pos_attrib_idx, 0);
+    
+    // rewritten on every mouse move while brushing -> streamed
+    m_vbo = std::make_unique<gl::StreamBuffer>("AxisBrush", num_axis * 4 * sizeof(Point));
+}
+
+bool AxisBrush::draw() const {
+    if (m_brushes.empty()) {
+        return true;
+    }
+    
+    glUseProgram(m_program);
+    gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "color"), m_color);
+    
+    glBindVertexArray(m_vao.id());
+    for (int i = 0; i < m_brushes.size(); i++) {
+        glDrawArrays(GL_LINE_LOOP, i * 4, 4);
+    }
+    return true;
+}
+
+bool AxisBrush::registerTool() {
+    // rectangles stay on their axis when axis move
+    auto graph = m_linkedApp->getGraph();
+    auto node = graph->addNode("brush rectangles", [this]() { uploadVertices(); });
+    graph->addDependency(node, m_linkedApp->getAxisNode());
+    
+    // rows added by the loader may fall into existing brushes
+    auto selection = graph->addNode("brush selection", [this]() {
+        if (!m_brushes.empty()) {
+            updateSelection();
+        }
+    });
+    graph->addDependency(selection, m_linkedApp->getRowsNode());
+    return true;
+}
+
+glm::vec2 AxisBrush::toPolyline(const glm::vec2& cursor) const {
+    float x = Utils::remap(cursor.x, glm::vec2(0, m_linkedApp->resolution().x), glm::vec2(-1,1));
+    float y = Utils::remap(cursor.y, glm::vec2(0, m_linkedApp->resolution().y), glm::vec2(-1,1));
+    auto pos = m_mouse_model * glm::vec4(glm::vec2(x,y), 0, 1);
+    return glm::vec2(pos.x, pos.y);
+}
+
+int AxisBrush::attributeAt(const glm::vec2& cursor) const {
+    // same width as the axis rectangles of AxisDrag
+    auto pos = toPolyline(cursor);
+    const auto& axis = *m_linkedApp->getAxis();
+    int attribute = -1;
+    for (int i = 0; i < axis.size(); i++) {
+        if (glm::abs(axis[i] - pos.x) <= 0.025f) {
+            attribute = i;
+        }
+    }
+    return attribute;
+}
+
+bool AxisBrush::startBrush(const glm::vec2& cursor) {
+    auto pos = toPolyline(cursor);
+    int attribute = attributeAt(cursor);
+    if (attribute < 0) {
+        return false;
+    }
+    
+    // a new drag replaces the brush of that axis
+    auto it = std::find_if(m_brushes.begin(), m_brushes.end(), [&](const Brush& brush) { return brush.attribute == attribute; });
+    if (it == m_brushes.end()) {
+        m_brushes.push_back(Brush{attribute, pos.y, pos.y});
+        it = m_brushes.end() - 1;
+    }
+    else {
+        *it = Brush{attribute, pos.y, pos.y};
+    }
+    m_active = it - m_brushes.begin();
+    
+    uploadVertices();
+    return true;
+}
+
+void AxisBrush::updateBrush(const glm::vec2& cursor) {
+    if (m_active < 0) {
+        return;
+    }
+
+    m_brushes[m_active].end = glm::clamp(toPolyline(cursor).y, -1.0f, 1.0f);
+    uploadVertices();
+    updateSelection();
+}
+
+void AxisBrush::stopBrush(const glm::vec2& cursor) {
+    if (m_active < 0) {
+        return;
+    }
+    
+    // click without drag removes the brush
+    updateBrush(cursor);
+    if (m_brushes[m_active].start == m_brushes[m_active].end) {
+        m_brushes.erase(m_brushes.begin() + m_active);
+        uploadVertices();
+        updateSelection();
+    }
+    m_active = -1;
+}
+
+void AxisBrush::removeBrush(const int& attribute) {
+    auto it = std::find_if(m_brushes.begin(), m_brushes.end(), [&](const Brush& brush) { return brush.attribute == attribute; });
+    if (it == m_brushes.end()) {
+        return;
+    }
+    
+    m_brushes.erase(it);
+    m_active = -1;
+    uploadVertices();
+    updateSelection();
+}
+
+void AxisBrush::updateSelection() {
+    /**
+     * Every brush is a slice of the attribute's sorted rows. The smallest 
+     * slice is walked, all other brushes are tested per row, so cost 
+     * scales with the matches instead of the row count.
+    **/
+
+    // only clear bits which were set, grows with appended rows
+    const auto& index = *m_linkedApp->getAxisIndex();
+    m_selection.resize((index.rows() + 63) / 64, 0);
+    for (const auto& id : m_selection_ids) {
+        m_selection[id / 64] &= ~(uint64_t(1) << (id % 64));
+    }
+    m_selection_ids.clear();
+    
+    if (m_brushes.empty()) {
+        m_linkedApp->updateColor(m_selection_ids, true);
+        return;
+    }
+    
+    const auto& ranges = *m_linkedApp->getRanges();
+    auto toData = [&](const Brush& brush) {
+        float start = Utils::remap(brush.start, glm::vec2(-1,1), ranges[brush.attribute]);
+        float end = Utils::remap(brush.end, glm::vec2(-1,1), ranges[brush.attribute]);
+        return glm::vec2(glm::min(start, end), glm::max(start, end));
+    };
+
+    int smallest = 0;
+    AxisIndex::Slice slice = {nullptr, nullptr};
+    for (int i = 0; i < m_brushes.size(); i++) {
+        auto range = toData(m_brushes[i]);
+        auto current = index.range(m_brushes[i].attribute, range.x, range.y);
+        if (i == 0 || current.second - current.first < slice.second - slice.first) {
+            slice = current;
+            smallest = i;
+        }
+    }
+
+    for (auto row = slice.first; row != slice.second; row++) {
+        bool inside = true;
+        for (int i = 0; i < m_brushes.size() && inside; i++) {
+            auto range = toData(m_brushes[i]);
+            float value = index.value(m_brushes[i].attribute, *row);
+            inside = i == smallest || (value >= range.x && value <= range.y);
+        }
+        if (inside) {
+            m_selection[*row / 64] |= uint64_t(1) << (*row % 64);
+            m_selection_ids.push_back(*row);
+        }
+    }
+    
+    m_linkedApp->updateColor(m_selection_ids);
+}
+
+void AxisBrush::uploadVertices() {
+    // rectangles in screen space around brushed part of the axis
+    const auto& axis = *m_linkedApp->getAxis();
+    const auto& model = m_linkedApp->getModel();
+    m_vertices.clear();
+    for (const auto& brush : m_brushes) {
+        float left = (axis[brush.attribute] - 0.03f) * model[0][0];
+        float right = (axis[brush.attribute] + 0.03f) * model[0][0];
+        float top = glm::max(brush.start, brush.end) * model[1][1];
+        float bottom = glm::min(brush.start, brush.end) * model[1][1];
+        m_vertices.push_back(Point{glm::vec2(left, top)});
+        m_vertices.push_back(Point{glm::vec2(right, top)});
+        m_vertices.push_back(Point{glm::vec2(right, bottom)});
+        m_vertices.push_back(Point{glm::vec2(left, bottom)});
+    }
+    
+    if (m_vertices.empty()) {
+        return;
+    }
+    m_vbo->write(m_vertices.data(), Utils::vectorsizeof(m_vertices));
+    glVertexArrayVertexBuffer(m_vao.id(), 0, m_vbo->id(), m_vbo->offset(), sizeof(Point));
+}
+
+const std::vector<uint64_t>& AxisBrush::getSelection() const {
+    return m_selection;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <spdlog/spdlog.h>
+#include <gl/stream_buffer.hpp>
+#include <gl/resource.hpp>
+
+#include <tool.hpp>
+#include <structs.hpp>
+#include <utils.hpp>
+#include <graphApp.hpp>
+#include <axisIndex.hpp>
+
+class AxisBrush : Tool {
+public:
+    AxisBrush(GraphApp* app);
+    bool draw() const override;
+    bool registerTool() override;
+    bool startBrush(const glm::vec2& cursor);
+    void updateBrush(const glm::vec2& cursor);
+    void stopBrush(const glm::vec2& cursor);
+    void removeBrush(const int& attribute);
+    int attributeAt(const glm::vec2& cursor) const; // axis under the cursor, -1 if none
+    const std::vector<uint64_t>& getSelection() const;
+
+private:
+    struct Brush {
+        int attribute;
+        float start; // polyline space y, start and end of drag
+        float end;
+    };
+    
+    glm::vec2 toPolyline(const glm::vec2& cursor) const;
+    void updateSelection();
+    void uploadVertices();
+    
+    glm::mat4 m_mouse_model; // scale of screen to polyine
+    GLuint m_program;
+    gl::VertexArray m_vao;
+    std::unique_ptr<gl::StreamBuffer> m_vbo;
+    
+    std::vector<Brush> m_brushes; // at most one per attribute
+    int m_active; // brush being dragged, -1 if none
+    std::vector<Point> m_vertices;
+    std::vector<uint64_t> m_selection; // bit per row
+    std::vector<int> m_selection_ids; // set bits, only these get cleared again
+    glm::vec4 m_color;
+};
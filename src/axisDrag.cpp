@@ -4,9 +4,7 @@ AxisDrag::AxisDrag(GraphApp* app) :
 	Tool{app},
     m_axis_status{std::vector<bool>(m_linkedApp->getAxis()->size(), false)}
 {
-    auto vert_shader = gl::load_shader_from_file("shaders/axis.vert", GL_VERTEX_SHADER);
-    auto frag_shader = gl::load_shader_from_file("shaders/axis.frag", GL_FRAGMENT_SHADER);
-    m_program = gl::create_program({vert_shader, frag_shader});
+    m_program = m_linkedApp->getProgramLibrary()->program({"shaders/axis.vert", "shaders/axis.frag"});
 	
     // model relative to Polylines scale
     m_draw_model = m_linkedApp->getModel();
@@ -32,29 +30,14 @@ AxisDrag::AxisDrag(GraphApp* app) :
     initializeIndexBuffer();
 }
 
-AxisDrag::~AxisDrag() {
-    if (glIsBuffer(m_vbo)) {
-        glDeleteBuffers(1, &m_vbo);
-    }
-    if (glIsVertexArray(m_vao)) {
-        glDeleteVertexArrays(1, &m_vao);
-    }
-    if (glIsBuffer(m_ibo)) {
-        glDeleteBuffers(1, &m_ibo);
-    }
-    if (glIsProgram(m_program)) {
-        glDeleteProgram(m_program);
-    }
-}
-
 bool AxisDrag::draw() const {
     glUseProgram(m_program);
     gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "transform"), m_draw_model);
     gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "default_color"), m_default_color);
     gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "active_color"), m_active_color);
      
-    glBindVertexArray(m_vao);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
+    glBindVertexArray(m_vao.id());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo.id());
     glDrawElements(GL_TRIANGLE_STRIP, m_indicies.size(), GL_UNSIGNED_SHORT, (const void*) 0);
     
     return true;
@@ -70,7 +53,9 @@ bool AxisDrag::checkSelection() {
     float y = Utils::remap(pos.y, glm::vec2(0, m_linkedApp->resolution().y), glm::vec2(-1,1));
     auto ss_pos = m_mouse_model * glm::vec4(glm::vec2(x,y), 0, 1);
     
-    std::vector<bool> current (m_axis_status.size(), false);
+    // scratch is reused, hovering doesn't allocate
+    auto& current = m_axis_hover;
+    current.assign(m_axis_status.size(), false);
     
     // check for intersection with multiple axis
     bool result = false;
@@ -91,7 +76,7 @@ bool AxisDrag::checkSelection() {
     
     // if there is a diffrence to last check update colors
     if (current != m_axis_status) {
-        m_axis_status = current;
+        m_axis_status.swap(current);
         updateColors();
     }
 
@@ -103,13 +88,21 @@ void AxisDrag::updateColors() {
         m_vertices[i].colorIndx = m_axis_status[(int)(i / 4)];
     }
 
-    // sub only the 4 verts of selected axis
-    glNamedBufferSubData(m_vbo, 0, Utils::vectorsizeof(m_vertices), m_vertices.data());
+    uploadVertices();
+}
+
+void AxisDrag::uploadVertices() {
+    // every upload lands in a fresh region of the stream buffer -> rebind vertex buffer offset
+    m_vbo->write(m_vertices.data(), Utils::vectorsizeof(m_vertices));
+    glVertexArrayVertexBuffer(m_vao.id(), 0, m_vbo->id(), m_vbo->offset(), sizeof(AxisVertex));
 }
 
 bool AxisDrag::updateSelection(const glm::vec2& prev, const glm::vec2& current) {
     bool moveing = false;
-    auto axis = *m_linkedApp->getAxis();
+    
+    // work on scratch copy, only allocates the first time
+    auto& axis = m_axis_scratch;
+    axis.assign(m_linkedApp->getAxis()->begin(), m_linkedApp->getAxis()->end());
     
     float scaled_prev_x = Utils::remap(prev.x, glm::vec2(0, m_linkedApp->resolution().x), glm::vec2(-1,1));
     float scaled_currnet_x = Utils::remap(current.x, glm::vec2(0, m_linkedApp->resolution().x), glm::vec2(-1,1));
@@ -123,6 +116,25 @@ bool AxisDrag::updateSelection(const glm::vec2& prev, const glm::vec2& current)
         }
     }
     
+    setAxis(axis);
+    
+    return moveing;
+}
+
+void AxisDrag::applyOrder(const std::vector<int>& order) {
+    // axis keep their current slots, only the attribute per slot changes
+    auto& axis = m_axis_scratch;
+    axis.assign(m_linkedApp->getAxis()->begin(), m_linkedApp->getAxis()->end());
+    std::vector<float> slots = axis;
+    std::sort(slots.begin(), slots.end());
+    for (int i = 0; i < order.size(); i++) {
+        axis[order[i]] = slots[i];
+    }
+
+    setAxis(axis);
+}
+
+void AxisDrag::setAxis(const std::vector<float>& axis) {
     // re-sort axis since order might have changed
     if (Utils::sortWithIndecies(axis, m_order)) {
         // if order change, update vertices
@@ -132,37 +144,35 @@ bool AxisDrag::updateSelection(const glm::vec2& prev, const glm::vec2& current)
     // update verts (axis_ssbo) and axis (verts for axis rect)
     m_linkedApp->updateAxis(axis);
     updateAxis(axis);
-    
-    return moveing;
 }
 
 void AxisDrag::updateAxis(const std::vector<float>& axis) {
-    m_vertices.clear();
-    for (const auto& i : axis) {
-        m_vertices.push_back(AxisVertex{glm::vec2(i - m_thickness / 2,  1.05), 0});
-        m_vertices.push_back(AxisVertex{glm::vec2(i + m_thickness / 2,  1.05), 0});
-        m_vertices.push_back(AxisVertex{glm::vec2(i - m_thickness / 2, -1.05), 0});
-        m_vertices.push_back(AxisVertex{glm::vec2(i + m_thickness / 2, -1.05), 0});
+    // number of axis is fixed, rewrite rectangles in place
+    m_vertices.resize(axis.size() * 4);
+    for (int j = 0; j < axis.size(); j++) {
+        auto i = axis[j];
+        m_vertices[j * 4]     = AxisVertex{glm::vec2(i - m_thickness / 2,  1.05), 0};
+        m_vertices[j * 4 + 1] = AxisVertex{glm::vec2(i + m_thickness / 2,  1.05), 0};
+        m_vertices[j * 4 + 2] = AxisVertex{glm::vec2(i - m_thickness / 2, -1.05), 0};
+        m_vertices[j * 4 + 3] = AxisVertex{glm::vec2(i + m_thickness / 2, -1.05), 0};
     }
 
-    glNamedBufferSubData(m_vbo, 0, Utils::vectorsizeof(m_vertices), m_vertices.data());
+    uploadVertices();
 }
 
 void AxisDrag::initializeVertexBuffers() {
     // setup vertex array object and vertex buffer
-    glCreateVertexArrays(1, &m_vao);
-    glCreateBuffers(1, &m_vbo);
-    glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, sizeof(AxisVertex));
+    m_vao = gl::VertexArray{"AxisDrag"};
 
     GLuint pos_attrib_idx = 0;
-    glEnableVertexArrayAttrib(m_vao, pos_attrib_idx);
-    glVertexArrayAttribFormat(m_vao, pos_attrib_idx, 2, GL_FLOAT, false, offsetof(AxisVertex, pos));
-    glVertexArrayAttribBinding(m_vao, pos_attrib_idx, 0);
+    glEnableVertexArrayAttrib(m_vao.id(), pos_attrib_idx);
+    glVertexArrayAttribFormat(m_vao.id(), pos_attrib_idx, 2, GL_FLOAT, false, offsetof(AxisVertex, pos));
+    glVertexArrayAttribBinding(m_vao.id(), pos_attrib_idx, 0);
 
     GLuint color_attrib_idx = 1;
-    glEnableVertexArrayAttrib(m_vao, color_attrib_idx);
-    glVertexArrayAttribFormat(m_vao, color_attrib_idx, 1, GL_FLOAT, false, offsetof(AxisVertex, colorIndx));
-    glVertexArrayAttribBinding(m_vao, color_attrib_idx, 0);
+    glEnableVertexArrayAttrib(m_vao.id(), color_attrib_idx);
+    glVertexArrayAttribFormat(m_vao.id(), color_attrib_idx, 1, GL_FLOAT, false, offsetof(AxisVertex, colorIndx));
+    glVertexArrayAttribBinding(m_vao.id(), color_attrib_idx, 0);
 
     /** init indecies for MultiDrawArrays call
      * 0 +----+ 1
@@ -177,7 +187,9 @@ void AxisDrag::initializeVertexBuffers() {
         m_vertices.push_back(AxisVertex{glm::vec2(i + m_thickness / 2, -1.05), 0});
     }  
 
-    glNamedBufferData(m_vbo, Utils::vectorsizeof(m_vertices), m_vertices.data(), GL_DYNAMIC_DRAW);
+    // rewritten on every axis move and hover -> streamed
+    m_vbo = std::make_unique<gl::StreamBuffer>("AxisDrag", Utils::vectorsizeof(m_vertices));
+    uploadVertices();
 }
 
 void AxisDrag::initializeIndexBuffer() {
@@ -190,7 +202,5 @@ void AxisDrag::initializeIndexBuffer() {
     }
     
     // Bind to Element array buffer -> Indexing so DrawElements can be used
-    glGenBuffers(1, &m_ibo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, Utils::vectorsizeof(m_indicies), m_indicies.data(), GL_STATIC_DRAW);
+    m_ibo = gl::Buffer("AxisDrag", Utils::vectorsizeof(m_indicies), m_indicies.data());
 }
\ No newline at end of file
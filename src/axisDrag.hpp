@@ -8,28 +8,32 @@
 class AxisDrag : Tool {
 public:
 	AxisDrag(GraphApp* app);
-	~AxisDrag();
 	bool draw() const override;
 	bool registerTool() override;
 	bool checkSelection();
 	bool updateSelection(const glm::vec2& prev, const glm::vec2& current);
+	void applyOrder(const std::vector<int>& order);
+	void setAxis(const std::vector<float>& axis);
 	
 private:
 	void updateAxis(const std::vector<float>& axis);
 	void updateColors();
+	void uploadVertices();
 	void initializeVertexBuffers();
 	void initializeIndexBuffer();
 	
 	glm::mat4 m_draw_model; // scale of polyline
 	glm::mat4 m_mouse_model; // scale of screen to polyine
     GLuint m_program;
-    GLuint m_vao;
-    GLuint m_vbo;
-    GLuint m_ibo;
+    gl::VertexArray m_vao;
+    std::unique_ptr<gl::StreamBuffer> m_vbo;
+    gl::Buffer m_ibo;
 
 	std::vector<AxisVertex> m_vertices;
 	std::vector<unsigned short> m_indicies;
 	std::vector<bool> m_axis_status;
+	std::vector<bool> m_axis_hover; // scratch for checkSelection
+	std::vector<float> m_axis_scratch; // scratch for updateSelection
 	std::vector<int> m_order;
 	
 	float m_thickness;
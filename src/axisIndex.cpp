@@ -0,0 +1,44 @@
+#include <axisIndex.hpp>
+#include <utils.hpp>
+#include <numeric>
+
+AxisIndex::AxisIndex(int num_attributes) :
+    m_num_attributes{num_attributes},
+    m_sorted(num_attributes)
+{
+}
+
+void AxisIndex::append(const ColumnStore::View& columns) {
+    size_t first = rows();
+    size_t count = columns.rows() - first;
+    m_columns = columns;
+    
+    // attributes are independent -> one sort & merge per core
+    Utils::parallelFor(m_num_attributes, [&](size_t a) {
+        auto& sorted = m_sorted[a];
+        auto less = [this, a](uint32_t i, uint32_t j) { return m_columns(a, i) < m_columns(a, j); };
+        sorted.resize(first + count);
+        std::iota(sorted.begin() + first, sorted.end(), uint32_t(first));
+        std::sort(sorted.begin() + first, sorted.end(), less);
+        std::inplace_merge(sorted.begin(), sorted.begin() + first, sorted.end(), less);
+    });
+}
+
+AxisIndex::Slice AxisIndex::range(int attribute, float lo, float hi) const {
+    const auto& sorted = m_sorted[attribute];
+    auto begin = std::lower_bound(sorted.begin(), sorted.end(), lo, [this, attribute](uint32_t row, float value) { 
+        return m_columns(attribute, row) < value; 
+    });
+    auto end = std::upper_bound(begin, sorted.end(), hi, [this, attribute](float value, uint32_t row) { 
+        return value < m_columns(attribute, row); 
+    });
+    return Slice{sorted.data() + (begin - sorted.begin()), sorted.data() + (end - sorted.begin())};
+}
+
+float AxisIndex::value(int attribute, uint32_t row) const {
+    return m_columns(attribute, row);
+}
+
+size_t AxisIndex::rows() const {
+    return m_columns.rows();
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <columnStore.hpp>
+
+/**
+ * Row ids of every attribute sorted by value, so rows within a value range 
+ * are a contiguous slice found by binary search. Appended rows are sorted 
+ * on their own and merged in, the permutations are never rebuilt. Values 
+ * are read through the shared column store, only the ids are kept here.
+**/
+class AxisIndex {
+public:
+    using Slice = std::pair<const uint32_t*, const uint32_t*>;
+
+    AxisIndex(int num_attributes = 0);
+    void append(const ColumnStore::View& columns); // rows of the view beyond the indexed ones
+    Slice range(int attribute, float lo, float hi) const; // rows with lo <= value <= hi
+    float value(int attribute, uint32_t row) const;
+    size_t rows() const;
+
+private:
+    int m_num_attributes;
+    ColumnStore::View m_columns;
+    std::vector<std::vector<uint32_t>> m_sorted; // per attribute, row ids ordered by value
+};
@@ -0,0 +1,122 @@
+#include <benchmark.hpp>
+#include <spdlog/spdlog.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+Benchmark::Benchmark(const std::string& baselinePath, const std::string& dataset) :
+    m_path{baselinePath},
+    m_dataset{dataset},
+    m_matching{false}
+{
+    /**
+     * Baseline file: 'dataset <name>' followed by one line per routine,
+     * '<name> <median ms> <deviation ms>'.
+    **/
+
+    std::ifstream file(m_path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        std::string key;
+        stream >> key;
+        if (key == "dataset") {
+            std::string name;
+            stream >> name;
+            m_matching = name == m_dataset;
+            continue;
+        }
+        Result result{key, 0.0, 0.0};
+        if (stream >> result.median >> result.deviation) {
+            m_baseline.push_back(result);
+        }
+    }
+    if (!m_baseline.empty() && !m_matching) {
+        spdlog::warn("Baseline '{}' was measured on another dataset", m_path);
+    }
+}
+
+double Benchmark::median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+bool Benchmark::hasBaseline() const {
+    return m_matching && !m_baseline.empty();
+}
+
+bool Benchmark::compare() const {
+    bool passed = true;
+    for (const auto& result : m_results) {
+        auto base = std::find_if(m_baseline.begin(), m_baseline.end(), [&](const Result& r) { return r.name == result.name; });
+        if (base == m_baseline.end()) {
+            spdlog::info("{:<18} {:>9.3f} ms   (no baseline)", result.name, result.median);
+            continue;
+        }
+        
+        // 1.4826 scales the median absolute deviation to a standard deviation
+        double noise = NOISE * 1.4826 * std::max(result.deviation, base->deviation) + RESOLUTION_MS;
+        double limit = base->median + std::max(TOLERANCE * base->median, noise);
+        bool regressed = result.median > limit;
+        passed &= !regressed;
+        
+        double change = base->median > 0.0 ? 100.0 * (result.median / base->median - 1.0) : 0.0;
+        auto report = fmt::format("{:<18} {:>9.3f} ms   baseline {:>9.3f} ms   {:>+7.1f}%   limit {:>9.3f} ms", 
+            result.name, result.median, base->median, change, limit);
+        if (regressed) {
+            spdlog::error("{}   REGRESSED", report);
+        }
+        else {
+            spdlog::info(report);
+        }
+    }
+    return passed;
+}
+
+void Benchmark::store() const {
+    auto directory = std::filesystem::path(m_path).parent_path();
+    if (!directory.empty()) {
+        std::filesystem::create_directories(directory);
+    }
+    std::ofstream file(m_path);
+    if (!file) {
+        throw std::runtime_error("Failed to write baseline '" + m_path + "'");
+    }
+    file << "dataset " << m_dataset << "\n";
+    for (const auto& result : m_results) {
+        file << result.name << " " << result.median << " " << result.deviation << "\n";
+        spdlog::info("{:<18} {:>9.3f} ms   +- {:.3f} ms", result.name, result.median, result.deviation);
+    }
+    spdlog::info("Stored baseline '{}'", m_path);
+}
+
+void Benchmark::writeSyntheticCsv(const std::string& path, const size_t& rows, const int& attributes) {
+    // clusters of gaussian values and a class column like iris, fixed seed -> same file on every machine
+    const int classes = 4;
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> center_distribution(0.0f, 10.0f);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::vector<float> centers(classes * attributes);
+    for (auto& center : centers) {
+        center = center_distribution(random);
+    }
+    
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Failed to write '" + path + "'");
+    }
+    file.setf(std::ios::fixed);
+    file.precision(4);
+    for (size_t row = 0; row < rows; row++) {
+        int label = row % classes;
+        for (int a = 0; a < attributes; a++) {
+            file << centers[label * attributes + a] + noise(random) << ",";
+        }
+        file << "class-" << label << "\n";
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * Medians of repeated runs, compared against a baseline file. A routine 
+ * regresses when its median exceeds the baseline by more than the 
+ * tolerance and by more than the noise (median absolute deviation) of 
+ * both runs. Baselines are only compared on the same synthetic dataset.
+**/
+class Benchmark {
+public:
+    Benchmark(const std::string& baselinePath, const std::string& dataset);
+    
+    template<typename F>
+    void measure(const std::string& name, F&& run, const int& repetitions = 11) {
+        // warm caches, pools and drivers first
+        for (int i = 0; i < WARMUP; i++) {
+            run();
+        }
+        std::vector<double> times;
+        for (int i = 0; i < repetitions; i++) {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        double median = Benchmark::median(times);
+        for (auto& time : times) {
+            time = std::abs(time - median);
+        }
+        m_results.push_back(Result{name, median, Benchmark::median(times)});
+    }
+    
+    bool hasBaseline() const;
+    bool compare() const; // false -> at least one routine regressed
+    void store() const;
+    static void writeSyntheticCsv(const std::string& path, const size_t& rows, const int& attributes);
+
+private:
+    static const int WARMUP = 2;
+    static constexpr double TOLERANCE = 0.1; // relative slowdown that is accepted
+    static constexpr double NOISE = 3.0; // scaled deviations that are accepted
+    static constexpr double RESOLUTION_MS = 0.05; // timer & scheduling jitter
+    
+    struct Result {
+        std::string name;
+        double median; // ms
+        double deviation; // median absolute deviation, ms
+    };
+    
+    static double median(std::vector<double> values);
+    
+    std::string m_path;
+    std::string m_dataset; // name of the synthetic dataset the results belong to
+    std::vector<Result> m_results;
+    std::vector<Result> m_baseline;
+    bool m_matching; // baseline was measured on the same dataset
+};
@@ -3,9 +3,7 @@
 BoxSelect::BoxSelect(GraphApp* app) :
     Tool{app}
 {
-    auto vert_shader = gl::load_shader_from_file("shaders/selection_rect.vert", GL_VERTEX_SHADER);
-    auto frag_shader = gl::load_shader_from_file("shaders/selection_rect.frag", GL_FRAGMENT_SHADER);
-    m_program = gl::create_program({vert_shader, frag_shader});
+    m_program = m_linkedApp->getProgramLibrary()->program({"shaders/selection_rect.vert", "shaders/selection_rect.frag"});
     
     // model relative to Polylines scale
     m_model= glm::scale(glm::mat4{1.0f}, glm::vec3{
@@ -18,30 +16,17 @@ BoxSelect::BoxSelect(GraphApp* app) :
     initializeVertexBuffers();
 }
 
-BoxSelect::~BoxSelect() {
-    if (glIsBuffer(m_vbo)) {
-        glDeleteBuffers(1, &m_vbo);
-    }
-    if (glIsVertexArray(m_vao)) {
-        glDeleteVertexArrays(1, &m_vao);
-    } 
-    if (glIsProgram(m_program)) {
-        glDeleteProgram(m_program);
-    }
-}
-    
 void BoxSelect::initializeVertexBuffers() {
     // setup vertex array object and vertex buffer
-    glCreateVertexArrays(1, &m_vao);
-    glCreateBuffers(1, &m_vbo);
-    glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, sizeof(Point));
+    m_vao = gl::VertexArray{"BoxSelect"};
 
     GLuint pos_attrib_idx = 0;
-    glEnableVertexArrayAttrib(m_vao, pos_attrib_idx);
-    glVertexArrayAttribFormat(m_vao, pos_attrib_idx, 2, GL_FLOAT, false, offsetof(Point, pos));
-    glVertexArrayAttribBinding(m_vao, pos_attrib_idx, 0);
+    glEnableVertexArrayAttrib(m_vao.id(), pos_attrib_idx);
+    glVertexArrayAttribFormat(m_vao.id(), pos_attrib_idx, 2, GL_FLOAT, false, offsetof(Point, pos));
+    glVertexArrayAttribBinding(m_vao.id(), pos_attrib_idx, 0);
         
-    glNamedBufferData(m_vbo, Utils::vectorsizeof(m_vertices), NULL, GL_DYNAMIC_DRAW);
+    // rewritten on every mouse move while selecting -> streamed
+    m_vbo = std::make_unique<gl::StreamBuffer>("BoxSelect", Utils::vectorsizeof(m_vertices));
 }
 
 void BoxSelect::updateSelection_callback(const glm::vec2& cursor) const {
@@ -57,7 +42,8 @@ void BoxSelect::updateSelection_callback(const glm::vec2& cursor) const {
     ptr->m_vertices[2] = Point{  glm::vec2( m_selectionArea.c2.x, m_selectionArea.c2.y) };
     ptr->m_vertices[3] = Point{  glm::vec2( m_selectionArea.c1.x, m_selectionArea.c2.y) };
              
-    glNamedBufferSubData(m_vao, 0, Utils::vectorsizeof(m_vertices), m_vertices.data());
+    m_vbo->write(m_vertices.data(), Utils::vectorsizeof(m_vertices));
+    glVertexArrayVertexBuffer(m_vao.id(), 0, m_vbo->id(), m_vbo->offset(), sizeof(Point));
 
     // now check intersection;
     m_linkedApp->updateColor(checkIntersection());
@@ -99,7 +85,7 @@ bool BoxSelect::draw() const {
     glUseProgram(m_program);
     gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "color"), glm::vec4(0.639, 0.670, 0.741, 0.5));
         
-    glBindVertexArray(m_vao);
+    glBindVertexArray(m_vao.id());
     glDrawArrays(GL_LINE_LOOP, 0, m_vertices.size());
 
     return true;
@@ -124,9 +110,11 @@ bool BoxSelect::registerTool() {
     return true;
 }
   
-std::vector<int> BoxSelect::checkIntersection() const{
-    // list of selected line ID's - list to remove duplicates
-    std::list<int> selected;
+const std::vector<int>& BoxSelect::checkIntersection() const{
+    // selected line ID's, may contain duplicates - storage is reused between calls
+    BoxSelect* ptr =  const_cast<BoxSelect*> (this);
+    auto& selected = ptr->m_current_selection_ids;
+    selected.clear();
     
     // transform selection AABB relativ to Polylines 
     auto selection_p1 = m_model * glm::vec4( m_selectionArea.c1.x, m_selectionArea.c1.y, 0, 1 );
@@ -140,18 +128,22 @@ std::vector<int> BoxSelect::checkIntersection() const{
                   glm::min(selection_p1.y, selection_p2.y)) 
     };
         
-    // check every line if it is inside AABB - later maybe BSP
-    for (unsigned int i = 0; i < m_linkedApp->getIndicies()->size() - 1; i+=2) {
+    // check every segment of every line if it is inside AABB - later maybe BSP
+    const auto& columns = *m_linkedApp->getColumns();
+    const auto& axis = *m_linkedApp->getAxis();
+    const auto& ranges = *m_linkedApp->getRanges();
+    size_t lines = columns.rows();
+    for (size_t i = 0; i < m_linkedApp->getSegments()->size() * lines; i++) {
               
-        // Get Vertecies of line segment
-        Vertex v1 = (*m_linkedApp->getVertecies())[(*m_linkedApp->getIndicies())[i]];
-        Vertex v2 = (*m_linkedApp->getVertecies())[(*m_linkedApp->getIndicies())[i + 1]];
+        // segment major like the index buffer, values of the line at both ends of the segment
+        auto [left, right] = (*m_linkedApp->getSegments())[i / lines];
+        int id = int(i % lines);
         
-        auto x1 = (*m_linkedApp->getAxis())[v1.attIndx];
-        auto y1 = Utils::remap((*m_linkedApp->getData())[ m_linkedApp->getAxis()->size() * (int)v1.id + (int)v1.attIndx], (*m_linkedApp->getRanges())[(int)v1.attIndx], glm::vec2(-1,1));
+        auto x1 = axis[left];
+        auto y1 = Utils::remap(columns.value(left, id), ranges[left], glm::vec2(-1,1));
         
-        auto x2 = (*m_linkedApp->getAxis())[v2.attIndx];
-        auto y2 = Utils::remap((*m_linkedApp->getData())[ m_linkedApp->getAxis()->size() * (int)v2.id + (int)v2.attIndx], (*m_linkedApp->getRanges())[(int)v2.attIndx], glm::vec2(-1,1));
+        auto x2 = axis[right];
+        auto y2 = Utils::remap(columns.value(right, id), ranges[right], glm::vec2(-1,1));
 
         auto lineAABB = AABB {
             glm::vec2(glm::min(x1, x2), glm::max(y1, y2)),
@@ -164,7 +156,7 @@ std::vector<int> BoxSelect::checkIntersection() const{
             // check if either start or endpoint are within AABB
             // if they are, no need to check the other line verts
             if (Utils::insideAABB(glm::vec2(x1, y1), selectionAABB) || Utils::insideAABB(glm::vec2(x2, y2), selectionAABB)) {
-                selected.push_back(v1.id);
+                selected.push_back(id);
                 //i += m_linkedApp->getAxis()->size() - v1.attIndx - 1;
                 continue;
             }
@@ -180,7 +172,7 @@ std::vector<int> BoxSelect::checkIntersection() const{
             auto ratio_l = (selectionAABB.c1.x - x1) / dist;
             auto inter_l = Utils::bezier(ratio_l, glm::vec2(x1, y1), p1, p2, glm::vec2(x2, y2));
             if (inter_l.y < selectionAABB.c1.y && inter_l.y > selectionAABB.c2.y ) {
-                selected.push_back(v1.id);
+                selected.push_back(id);
                 //i += m_linkedApp->getAxis()->size() - v1.attIndx - 1;
                 continue;
             }
@@ -190,15 +182,12 @@ std::vector<int> BoxSelect::checkIntersection() const{
             double ratio_r = (selectionAABB.c2.x - x1) / dist;
             auto inter_r = Utils::bezier(ratio_r, glm::vec2(x1, y1), p1, p2, glm::vec2(x2, y2));
             if (inter_r.y < selectionAABB.c1.y && inter_r.y > selectionAABB.c2.y ) {
-                selected.push_back(v1.id);
+                selected.push_back(id);
                 //i += m_linkedApp->getAxis()->size() - v1.attIndx - 1;
                 continue;
             }
         }
     }
-        
-    BoxSelect* ptr =  const_cast<BoxSelect*> (this);
-    ptr -> m_current_selection_ids = std::vector<int>(selected.begin(), selected.end());
     
     return m_current_selection_ids;
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <spdlog/spdlog.h>
 #include <gl/program.hpp>
 #include <gl/shader.hpp>
+#include <gl/stream_buffer.hpp>
 
 #include <tool.hpp>
 #include <structs.hpp>
@@ -16,12 +17,11 @@
 class BoxSelect : Tool {
 public:
     BoxSelect(GraphApp* app);
-    ~BoxSelect();
     void initializeVertexBuffers();
     void clearSelection() const;
     bool draw() const override;
     bool registerTool() override;
-    std::vector<int> checkIntersection() const;
+    const std::vector<int>& checkIntersection() const;
     
     void stopSelection_callback() const;
     void updateSelection_callback(const glm::vec2& cursor) const;
@@ -30,8 +30,8 @@ public:
  protected:
     glm::mat4 m_model;
     GLuint m_program;
-    GLuint m_vao;
-    GLuint m_vbo;
+    gl::VertexArray m_vao;
+    std::unique_ptr<gl::StreamBuffer> m_vbo;
 
     std::vector<Point> m_vertices{Point{}, Point{}, Point{}, Point{}};
     std::vector<int> m_current_selection_ids;
@@ -0,0 +1,78 @@
+#include <columnStore.hpp>
+#include <stdexcept>
+
+ColumnStore::ColumnStore(const int& num_attributes) :
+    m_num_attributes{num_attributes},
+    m_rows{0},
+    m_blocks(num_attributes)
+{
+}
+
+ColumnStore::ColumnStore(const std::vector<const float*>& columns) :
+    m_num_attributes{int(columns.size())},
+    m_rows{0},
+    m_mapped{columns}
+{
+}
+
+void ColumnStore::append(const float* rows, const size_t& count) {
+    if (!m_mapped.empty()) {
+        m_rows += count;
+        return;
+    }
+
+    // views only read below their row count, new rows never touch those values
+    size_t blocks = (m_rows + count + BLOCK_ROWS - 1) / BLOCK_ROWS;
+    for (auto& column : m_blocks) {
+        while (column.size() < blocks) {
+            column.push_back(std::make_unique<float[]>(BLOCK_ROWS));
+        }
+    }
+    for (int a = 0; a < m_num_attributes; a++) {
+        for (size_t i = 0; i < count; i++) {
+            size_t row = m_rows + i;
+            m_blocks[a][row / BLOCK_ROWS][row % BLOCK_ROWS] = rows[i * m_num_attributes + a];
+        }
+    }
+    m_rows += count;
+}
+
+void ColumnStore::assign(const int& attribute, const std::vector<float>& values) {
+    if (!m_mapped.empty()) {
+        throw std::runtime_error("Mapped columns can't be assigned!");
+    }
+    for (size_t row = 0; row < m_rows && row < values.size(); row++) {
+        m_blocks[attribute][row / BLOCK_ROWS][row % BLOCK_ROWS] = values[row];
+    }
+}
+
+void ColumnStore::map(const int& attribute, const float* column) {
+    if (m_mapped.empty()) {
+        throw std::runtime_error("Owned columns can't be mapped!");
+    }
+    m_mapped[attribute] = column;
+}
+
+float ColumnStore::value(const int& attribute, const size_t& row) const {
+    if (!m_mapped.empty()) {
+        return m_mapped[attribute][row];
+    }
+    return m_blocks[attribute][row / BLOCK_ROWS][row % BLOCK_ROWS];
+}
+
+ColumnStore::View ColumnStore::view() const {
+    View view;
+    view.m_rows = m_rows;
+    view.m_block_count = (m_rows + BLOCK_ROWS - 1) / BLOCK_ROWS;
+    view.m_blocks.reserve(m_num_attributes * view.m_block_count);
+    for (int a = 0; a < m_num_attributes; a++) {
+        for (size_t b = 0; b < view.m_block_count; b++) {
+            view.m_blocks.push_back(m_mapped.empty() ? m_blocks[a][b].get() : m_mapped[a] + b * BLOCK_ROWS);
+        }
+    }
+    return view;
+}
+
+size_t ColumnStore::rows() const {
+    return m_rows;
+}
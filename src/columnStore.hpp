@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * Column major rows of the first time step, the one copy the cpu side 
+ * indices and statistics read from. Values live in fixed size blocks that 
+ * never move, so a view taken on the render thread stays valid for a 
+ * background task while more rows get appended behind it. Columns of a 
+ * mapped file are read in place instead, appending only counts their rows.
+**/
+class ColumnStore {
+public:
+    static constexpr size_t BLOCK_ROWS = 1 << 14;
+
+    // first rows() rows of every column, cheap to copy into tasks
+    class View {
+    public:
+        float operator()(const int& attribute, const size_t& row) const {
+            return m_blocks[attribute * m_block_count + row / BLOCK_ROWS][row % BLOCK_ROWS];
+        }
+        size_t rows() const {
+            return m_rows;
+        }
+
+    private:
+        friend class ColumnStore;
+        std::vector<const float*> m_blocks; // attribute major
+        size_t m_block_count = 0; // blocks per attribute
+        size_t m_rows = 0;
+    };
+
+    ColumnStore(const int& num_attributes = 0);
+    ColumnStore(const std::vector<const float*>& columns); // columns of a mapped file, nothing is copied
+    void append(const float* rows, const size_t& count); // row major, num_attributes floats per row
+    void assign(const int& attribute, const std::vector<float>& values); // in place, no view may be read meanwhile
+    void map(const int& attribute, const float* column); // mapped columns only
+    float value(const int& attribute, const size_t& row) const;
+    View view() const;
+    size_t rows() const;
+
+private:
+    int m_num_attributes;
+    size_t m_rows;
+    std::vector<const float*> m_mapped; // per attribute, empty if values are owned
+    std::vector<std::vector<std::unique_ptr<float[]>>> m_blocks; // per attribute
+};
@@ -0,0 +1,142 @@
+#include <dataLoader.hpp>
+#include <utils.hpp>
+#include <spdlog/spdlog.h>
+#include <fstream>
+
+DataLoader::DataLoader(GLFWwindow* context, const Dataset& dataset, const size_t& firstChunkRows) :
+    m_context{context},
+    m_dataset{dataset},
+    m_attributes{int(dataset.columns.size())},
+    m_chunk_rows{std::max<size_t>(firstChunkRows, 1)},
+    m_total{0},
+    m_read{0},
+    m_finished{false},
+    m_stop{false}
+{
+    if (m_dataset.format == DataFormat::COLUMNAR) {
+        m_total = ColumnarFile(m_dataset.path).rows();
+    }
+    else {
+        std::ifstream file(m_dataset.path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            throw std::runtime_error("Failed to open data file '" + m_dataset.path + "'!");
+        }
+        m_total = file.tellg();
+    }
+    m_thread = std::thread(&DataLoader::run, this);
+}
+
+DataLoader::~DataLoader() {
+    m_stop = true;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    
+    for (auto& chunk : m_chunks) {
+        glDeleteSync(chunk.fence);
+    }
+    m_chunks.clear();
+    
+    // windows can only be destroyed on the main thread
+    glfwDestroyWindow(m_context);
+}
+
+bool DataLoader::poll(LoadedChunk& chunk) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_chunks.empty()) {
+        return false;
+    }
+
+    // fences are shared between contexts, staging buffer may still be in flight
+    GLenum status = glClientWaitSync(m_chunks.front().fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        return false;
+    }
+
+    chunk = std::move(m_chunks.front());
+    m_chunks.pop_front();
+    glDeleteSync(chunk.fence);
+    chunk.fence = nullptr;
+    return true;
+}
+
+bool DataLoader::done() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_finished && m_chunks.empty();
+}
+
+float DataLoader::progress() const {
+    return m_total > 0 ? float(m_read) / m_total : 1.0f;
+}
+
+void DataLoader::run() {
+    glfwMakeContextCurrent(m_context);
+    if (m_dataset.format == DataFormat::COLUMNAR) {
+        readColumnar();
+    }
+    else {
+        readCsv();
+    }
+    m_read = m_total;
+    m_finished = true;
+    glfwMakeContextCurrent(nullptr);
+}
+
+void DataLoader::readCsv() {
+    // every line is split, but only projected fields are converted
+    std::ifstream file(m_dataset.path);
+    std::string line;
+    std::vector<float> rows;
+    size_t skipped = 0;
+    if (m_dataset.header && std::getline(file, line)) {
+        m_read += line.size() + 1;
+    }
+    while (!m_stop && std::getline(file, line)) {
+        m_read += line.size() + 1;
+        if (!m_dataset.parseLine(line, m_dataset.columns, rows)) {
+            skipped += line.find_first_not_of(" \t\r") != std::string::npos; // blank lines silently
+            continue;
+        }
+        
+        if (rows.size() >= m_chunk_rows * m_attributes) {
+            push(rows);
+            m_chunk_rows *= 2;
+        }
+    }
+    if (!rows.empty()) {
+        push(rows);
+    }
+    
+    if (skipped > 0) {
+        spdlog::warn("Skipped {} lines of '{}' without numeric values in all {} columns", skipped, m_dataset.path, m_dataset.names.size());
+    }
+}
+
+void DataLoader::readColumnar() {
+    // unused columns are never read
+    ColumnarFile file(m_dataset.path);
+    std::vector<float> rows;
+    for (size_t first = 0; !m_stop && first < file.rows(); ) {
+        size_t count = std::min(m_chunk_rows, file.rows() - first);
+        file.read(m_dataset.columns, first, count, rows);
+        push(rows);
+        first += count;
+        m_read = first;
+        m_chunk_rows *= 2;
+    }
+}
+
+void DataLoader::push(std::vector<float>& rows) {
+    LoadedChunk chunk;
+    chunk.staging = gl::Buffer("DataLoader", Utils::vectorsizeof(rows), rows.data());
+    chunk.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    
+    // fence has to reach the gpu before the main context can wait on it
+    glFlush();
+    
+    chunk.rows.swap(rows);
+    rows.clear();
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_chunks.push_back(std::move(chunk));
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <gl/resource.hpp>
+#include <dataset.hpp>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct LoadedChunk {
+    std::vector<float> rows; // row major, one time step
+    gl::Buffer staging; // same rows on the gpu, uploaded by the loader context
+    GLsync fence = nullptr; // signaled once staging is complete
+};
+
+/**
+ * Reads the projected columns of a dataset on a worker thread which owns a 
+ * context shared with the window. Chunks are uploaded into staging buffers right away, the main thread 
+ * only picks up chunks whose fence signaled and copies them on the gpu.
+ * Chunk sizes double, so the number of appends stays logarithmic in the rows.
+**/
+class DataLoader {
+public:
+    DataLoader(GLFWwindow* context, const Dataset& dataset, const size_t& firstChunkRows);
+    ~DataLoader();
+    bool poll(LoadedChunk& chunk); // next uploaded chunk, never blocks
+    bool done() const; // every chunk was handed out
+    float progress() const;
+
+private:
+    void run();
+    void readCsv();
+    void readColumnar();
+    void push(std::vector<float>& rows);
+
+    GLFWwindow* m_context;
+    Dataset m_dataset;
+    int m_attributes;
+    size_t m_chunk_rows;
+    size_t m_total; // bytes of csv, rows of columnar files
+    
+    std::thread m_thread;
+    mutable std::mutex m_mutex;
+    std::deque<LoadedChunk> m_chunks; // guarded by m_mutex
+    std::atomic<size_t> m_read; // same unit as m_total
+    std::atomic<bool> m_finished;
+    std::atomic<bool> m_stop;
+};
@@ -0,0 +1,284 @@
+#include <dataset.hpp>
+#include <utils.hpp>
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <cstring>
+
+static const char COLUMNAR_MAGIC[8] = {'G', 'L', 'P', 'C', 'O', 'L', 'S', '1'};
+static const uint64_t COLUMNAR_ALIGNMENT = 64;
+
+static bool parseFloat(const std::string& s, float& value) {
+    // whole field has to be a number, trailing whitespace (e.g. '\r') is fine
+    const char* begin = s.c_str();
+    char* end = nullptr;
+    value = std::strtof(begin, &end);
+    if (end == begin) {
+        return false;
+    }
+    while (*end == ' ' || *end == '\t' || *end == '\r') {
+        end++;
+    }
+    return *end == '\0';
+}
+
+static std::string directory(const std::string& path) {
+    auto slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? "" : path.substr(0, slash + 1);
+}
+
+static bool endsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+Dataset Dataset::open(const std::string& path) {
+    Dataset dataset;
+    dataset.path = path;
+    std::vector<std::string> projection;
+
+    // manifest names the file and the projected columns
+    if (endsWith(path, ".manifest")) {
+        std::ifstream manifest(path);
+        if (!manifest) {
+            throw std::runtime_error("Failed to open manifest '" + path + "'!");
+        }
+        std::string line;
+        while (std::getline(manifest, line)) {
+            std::istringstream tokens(line.substr(0, line.find('#')));
+            std::string directive, value;
+            tokens >> directive;
+            if (directive == "data" && tokens >> value) {
+                dataset.path = directory(path) + value;
+            }
+            else if (directive == "columns") {
+                while (tokens >> value) {
+                    projection.push_back(value);
+                }
+            }
+            else if (!directive.empty()) {
+                spdlog::warn("Unknown directive '{}' in '{}'", directive, path);
+            }
+        }
+    }
+    dataset.format = endsWith(dataset.path, ".cols") ? DataFormat::COLUMNAR : DataFormat::CSV;
+    
+    // column names, only the header is read
+    if (dataset.format == DataFormat::COLUMNAR) {
+        dataset.names = ColumnarFile(dataset.path).names();
+    }
+    else {
+        std::ifstream file(dataset.path);
+        std::string line;
+        if (!file || !std::getline(file, line)) {
+            throw std::runtime_error("Failed to open data file '" + dataset.path + "'!");
+        }
+        
+        // header if any but the last (label) field isn't a number
+        auto fields = Utils::splitString(line, ',', false, false);
+        for (int i = 0; i + 1 < fields.size(); i++) {
+            float value;
+            dataset.header |= !parseFloat(fields[i], value);
+        }
+        for (int i = 0; i < fields.size(); i++) {
+            dataset.names.push_back(dataset.header ? fields[i] : std::to_string(i));
+        }
+    }
+
+    // default: every column, without the label column of csv files
+    if (projection.empty()) {
+        int count = dataset.names.size() - (dataset.format == DataFormat::CSV ? 1 : 0);
+        for (int i = 0; i < count; i++) {
+            dataset.columns.push_back(i);
+        }
+    }
+    for (const auto& name : projection) {
+        auto it = std::find(dataset.names.begin(), dataset.names.end(), name);
+        if (it != dataset.names.end()) {
+            dataset.columns.push_back(it - dataset.names.begin());
+        }
+        else if (std::all_of(name.begin(), name.end(), ::isdigit) && std::stoi(name) < dataset.names.size()) {
+            dataset.columns.push_back(std::stoi(name));
+        }
+        else {
+            throw std::runtime_error("Unknown column '" + name + "' in '" + path + "'!");
+        }
+    }
+    if (dataset.columns.size() < 2) {
+        throw std::runtime_error("Dataset '" + path + "' needs at least two columns!");
+    }
+
+    spdlog::info("Dataset '{}': {} of {} columns", dataset.path, dataset.columns.size(), dataset.names.size());
+    return dataset;
+}
+
+bool Dataset::parseLine(const std::string& line, const std::vector<int>& columns, std::vector<float>& values) const {
+    // only projected fields are converted, lines that don't fit the header are skipped
+    auto fields = Utils::splitString(line, ',', false, false);
+    if (fields.size() != names.size()) {
+        return false;
+    }
+
+    size_t size = values.size();
+    for (const auto& column : columns) {
+        float value;
+        if (!parseFloat(fields[column], value)) {
+            values.resize(size);
+            return false;
+        }
+        values.push_back(value);
+    }
+    return true;
+}
+
+std::vector<float> Dataset::readColumn(const int& column) const {
+    // rows have to line up with the loaded ones -> same lines are skipped
+    std::vector<float> values;
+    if (format == DataFormat::COLUMNAR) {
+        ColumnarFile file(path);
+        file.read({column}, 0, file.rows(), values);
+        return values;
+    }
+
+    std::ifstream file(path);
+    std::string line;
+    std::vector<float> row;
+    if (header) {
+        std::getline(file, line);
+    }
+    while (std::getline(file, line)) {
+        row.clear();
+        if (!parseLine(line, columns, row)) {
+            continue;
+        }
+        if (!parseLine(line, {column}, values)) {
+            return {};
+        }
+    }
+    return values;
+}
+
+int Dataset::nextUnused(const int& column, const int& step) const {
+    int count = names.size();
+    for (int i = 1; i < count; i++) {
+        int next = ((column + i * step) % count + count) % count;
+        if (std::find(columns.begin(), columns.end(), next) == columns.end()) {
+            return next;
+        }
+    }
+    return -1;
+}
+
+void Dataset::convert(const std::string& target) const {
+    // projected columns only, a manifest can list all of them to keep everything
+    std::vector<float> rows;
+    std::vector<std::string> projected;
+    for (const auto& column : columns) {
+        projected.push_back(names[column]);
+    }
+
+    if (format == DataFormat::COLUMNAR) {
+        ColumnarFile file(path);
+        file.read(columns, 0, file.rows(), rows);
+    }
+    else {
+        std::ifstream file(path);
+        std::string line;
+        if (header) {
+            std::getline(file, line);
+        }
+        while (std::getline(file, line)) {
+            parseLine(line, columns, rows);
+        }
+    }
+
+    ColumnarFile::write(target, projected, rows);
+    spdlog::info("Converted {} rows of '{}' to '{}'", rows.size() / columns.size(), path, target);
+}
+
+ColumnarFile::ColumnarFile(const std::string& path) :
+    m_file{path, std::ios::binary},
+    m_rows{0},
+    m_data_offset{0}
+{
+    char magic[8];
+    uint32_t columns = 0;
+    if (!m_file.read(magic, sizeof(magic)) || std::memcmp(magic, COLUMNAR_MAGIC, sizeof(magic)) != 0) {
+        throw std::runtime_error("'" + path + "' is no columnar data file!");
+    }
+    m_file.read(reinterpret_cast<char*>(&m_rows), sizeof(m_rows));
+    m_file.read(reinterpret_cast<char*>(&columns), sizeof(columns));
+    for (uint32_t i = 0; i < columns; i++) {
+        uint32_t length = 0;
+        m_file.read(reinterpret_cast<char*>(&length), sizeof(length));
+        std::string name(length, ' ');
+        m_file.read(&name[0], length);
+        m_names.push_back(name);
+    }
+    if (!m_file) {
+        throw std::runtime_error("Failed to read header of '" + path + "'!");
+    }
+    
+    uint64_t end = m_file.tellg();
+    m_data_offset = (end + COLUMNAR_ALIGNMENT - 1) / COLUMNAR_ALIGNMENT * COLUMNAR_ALIGNMENT;
+}
+
+size_t ColumnarFile::rows() const {
+    return m_rows;
+}
+
+uint64_t ColumnarFile::dataOffset() const {
+    return m_data_offset;
+}
+
+const std::vector<std::string>& ColumnarFile::names() const {
+    return m_names;
+}
+
+void ColumnarFile::read(const std::vector<int>& columns, const size_t& first, const size_t& count, std::vector<float>& rows) {
+    // one contiguous read per column, interleaved into rows afterwards
+    size_t base = rows.size();
+    size_t num = columns.size();
+    rows.resize(base + count * num);
+    m_column.resize(count);
+    for (size_t i = 0; i < num; i++) {
+        m_file.seekg(m_data_offset + (columns[i] * m_rows + first) * sizeof(float));
+        m_file.read(reinterpret_cast<char*>(m_column.data()), count * sizeof(float));
+        for (size_t r = 0; r < count; r++) {
+            rows[base + r * num + i] = m_column[r];
+        }
+    }
+    if (!m_file) {
+        throw std::runtime_error("Failed to read columnar rows!");
+    }
+}
+
+void ColumnarFile::write(const std::string& path, const std::vector<std::string>& names, const std::vector<float>& rows) {
+    std::ofstream file(path, std::ios::binary);
+    uint64_t count = rows.size() / names.size();
+    uint32_t columns = names.size();
+    file.write(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    file.write(reinterpret_cast<const char*>(&columns), sizeof(columns));
+    for (const auto& name : names) {
+        uint32_t length = name.size();
+        file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        file.write(name.data(), length);
+    }
+    
+    // pad to the aligned data offset
+    uint64_t end = file.tellp();
+    uint64_t offset = (end + COLUMNAR_ALIGNMENT - 1) / COLUMNAR_ALIGNMENT * COLUMNAR_ALIGNMENT;
+    std::vector<char> padding(offset - end, 0);
+    file.write(padding.data(), padding.size());
+
+    // transpose one column at a time
+    std::vector<float> column(count);
+    for (uint32_t c = 0; c < columns; c++) {
+        for (uint64_t r = 0; r < count; r++) {
+            column[r] = rows[r * columns + c];
+        }
+        file.write(reinterpret_cast<const char*>(column.data()), count * sizeof(float));
+    }
+    if (!file) {
+        throw std::runtime_error("Failed to write '" + path + "'!");
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+enum class DataFormat {
+    CSV,     // comma separated text, optional header line
+    COLUMNAR // binary, see ColumnarFile
+};
+
+/**
+ * Which file to load and which of its columns become attributes, columns 
+ * that aren't projected are never parsed. Opened from a manifest or from 
+ * a data file directly ('.cols' is columnar, everything else csv).
+ *
+ * Manifest ('.manifest'), one directive per line, '#' starts a comment:
+ *     data sensors.cols        # relative to the manifest
+ *     columns 0 temp pressure  # indices or header names, in axis order
+**/
+struct Dataset {
+    std::string path;
+    DataFormat format = DataFormat::CSV;
+    bool header = false; // csv only, first line holds the names
+    std::vector<std::string> names; // every column of the file
+    std::vector<int> columns; // file column of every attribute
+
+    static Dataset open(const std::string& path);
+    bool parseLine(const std::string& line, const std::vector<int>& columns, std::vector<float>& values) const;
+    std::vector<float> readColumn(const int& column) const; // one value per loaded row, empty if not numeric
+    int nextUnused(const int& column, const int& step) const; // -1 if all columns are projected
+    void convert(const std::string& target) const;
+};
+
+/**
+ * Binary column major file: magic, row count, column names, then every 
+ * column as contiguous floats starting at a 64 byte aligned offset. 
+ * Reading some columns only touches their byte ranges.
+**/
+class ColumnarFile {
+public:
+    ColumnarFile(const std::string& path);
+    size_t rows() const;
+    uint64_t dataOffset() const; // byte offset of the first column
+    const std::vector<std::string>& names() const;
+    void read(const std::vector<int>& columns, const size_t& first, const size_t& count, std::vector<float>& rows); // appends row major
+    static void write(const std::string& path, const std::vector<std::string>& names, const std::vector<float>& rows);
+
+private:
+    std::ifstream m_file;
+    std::vector<std::string> m_names;
+    uint64_t m_rows;
+    uint64_t m_data_offset;
+    std::vector<float> m_column; // scratch for read
+};
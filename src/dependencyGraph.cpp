@@ -0,0 +1,92 @@
+#include <dependencyGraph.hpp>
+#include <spdlog/spdlog.h>
+
+DependencyGraph::Node DependencyGraph::addNode(const std::string& name, const std::function<void()>& update) {
+    m_nodes.push_back(Entry{name, update, {}, {}, false});
+    sortNodes();
+    return m_nodes.size() - 1;
+}
+
+void DependencyGraph::addDependency(const Node& node, const Node& dependsOn) {
+    m_nodes[dependsOn].dependents.push_back(node);
+    sortNodes();
+}
+
+void DependencyGraph::addOrdering(const Node& node, const Node& after) {
+    m_nodes[after].followers.push_back(node);
+    sortNodes();
+}
+
+void DependencyGraph::markDirty(const Node& node) {
+    // dependents of a dirty node are already dirty
+    if (m_nodes[node].dirty) {
+        return;
+    }
+
+    m_nodes[node].dirty = true;
+    for (const auto& dependent : m_nodes[node].dependents) {
+        markDirty(dependent);
+    }
+}
+
+bool DependencyGraph::isDirty(const Node& node) const {
+    return m_nodes[node].dirty;
+}
+
+void DependencyGraph::update() {
+    if (m_updating) {
+        return;
+    }
+    m_updating = true;
+
+    // nodes marked by an update further down are handled in the same pass,
+    // nodes further up stay dirty for the next one
+    for (const auto& node : m_order) {
+        auto& entry = m_nodes[node];
+        if (!entry.dirty) {
+            continue;
+        }
+        entry.dirty = false;
+        if (entry.update) {
+            entry.update();
+        }
+    }
+
+    m_updating = false;
+}
+
+void DependencyGraph::sortNodes() {
+    // Kahn's algorithm
+    std::vector<int> incoming(m_nodes.size(), 0);
+    for (const auto& entry : m_nodes) {
+        for (const auto& dependent : entry.dependents) {
+            incoming[dependent]++;
+        }
+        for (const auto& follower : entry.followers) {
+            incoming[follower]++;
+        }
+    }
+
+    m_order.clear();
+    for (Node i = 0; i < m_nodes.size(); i++) {
+        if (incoming[i] == 0) {
+            m_order.push_back(i);
+        }
+    }
+    for (int i = 0; i < m_order.size(); i++) {
+        for (const auto& dependent : m_nodes[m_order[i]].dependents) {
+            if (--incoming[dependent] == 0) {
+                m_order.push_back(dependent);
+            }
+        }
+        for (const auto& follower : m_nodes[m_order[i]].followers) {
+            if (--incoming[follower] == 0) {
+                m_order.push_back(follower);
+            }
+        }
+    }
+
+    if (m_order.size() != m_nodes.size()) {
+        throw std::runtime_error("Dependency graph contains a cycle!");
+    }
+}
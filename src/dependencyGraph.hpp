@@ -0,0 +1,37 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Derived state of the application as nodes with dependencies. Changing a node 
+ * marks it and everything depending on it dirty, update() then recomputes only 
+ * dirty nodes, each once and after all of its dependencies.
+**/
+class DependencyGraph {
+public:
+    using Node = int;
+
+    Node addNode(const std::string& name, const std::function<void()>& update = {});
+    void addDependency(const Node& node, const Node& dependsOn);
+    void addOrdering(const Node& node, const Node& after); // runs after, isn't dirtied by it
+    void markDirty(const Node& node);
+    bool isDirty(const Node& node) const;
+    void update();
+
+private:
+    struct Entry {
+        std::string name;
+        std::function<void()> update;
+        std::vector<Node> dependents;
+        std::vector<Node> followers; // ordering only
+        bool dirty;
+    };
+
+    void sortNodes();
+
+    std::vector<Entry> m_nodes;
+    std::vector<Node> m_order; // topological order, dependencies first
+    bool m_updating = false;
+};
@@ -9,7 +9,8 @@ ExpansionActive::ExpansionActive(const int& leftIdx, const int& rightIdx, const
 	m_linkedApp{app},
     m_program{program},
     m_leftAxisIndex{leftIdx},
-    m_rightAxisIndex{rightIdx}
+    m_rightAxisIndex{rightIdx},
+    m_owner{fmt::format("ExpansionActive {}-{}", leftIdx, rightIdx)}
 {  
     m_active = false;
     m_thickness = 0.05f;
@@ -30,42 +31,37 @@ void ExpansionActive::draw() const {
     gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "active_color"), m_active_color);
     gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "thickness_offset"), glm::vec4(m_thickness, -m_thickness, m_thickness, -m_thickness));
      
-    glBindVertexArray(m_vao);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, *m_linkedApp->getAttribute_SSBO());
+    // pool ranges may move on compaction, rebind them every draw
+    auto vertex_pool = m_linkedApp->getVertexPool();
+    auto index_pool = m_linkedApp->getIndexPool();
+    glVertexArrayVertexBuffer(m_vao.id(), 0, vertex_pool->id(), vertex_pool->offset(m_vertex_range), sizeof(Vertex));
+    glBindVertexArray(m_vao.id());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_pool->id());
+    m_linkedApp->getAttribute_SSBO()->bind_range(GL_SHADER_STORAGE_BUFFER, 3);
 
-    glDrawElements(GL_TRIANGLE_STRIP, m_indicies.size(), GL_UNSIGNED_SHORT, (const void*)0);
+    glDrawElements(GL_TRIANGLE_STRIP, m_indicies.size(), GL_UNSIGNED_SHORT, (const void*)index_pool->offset(m_index_range));
 }
 
 ExpansionActive::~ExpansionActive() {
-    if (glIsBuffer(m_vbo)) {
-        glDeleteBuffers(1, &m_vbo);
-    }
-    if (glIsVertexArray(m_vao)) {
-        glDeleteVertexArrays(1, &m_vao);
-    }
-    if (glIsBuffer(m_ibo)) {
-        glDeleteBuffers(1, &m_ibo);
-    }
+    m_linkedApp->getVertexPool()->release(m_vertex_range);
+    m_linkedApp->getIndexPool()->release(m_index_range);
 }
 
 void ExpansionActive::initializeVertexBuffers() {
 	// setup vertex array object and vertex buffer
-    glCreateVertexArrays(1, &m_vao);
-    glCreateBuffers(1, &m_vbo);
-    glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, sizeof(Vertex));
+    m_vao = gl::VertexArray{m_owner};
     
     // setup axis id attribute
     GLuint axis_attrib_idx = 0;
-    glEnableVertexArrayAttrib(m_vao, axis_attrib_idx);
-    glVertexArrayAttribFormat(m_vao, axis_attrib_idx, 1, GL_FLOAT, false, offsetof(Vertex, id));
-    glVertexArrayAttribBinding(m_vao, axis_attrib_idx, 0);
+    glEnableVertexArrayAttrib(m_vao.id(), axis_attrib_idx);
+    glVertexArrayAttribFormat(m_vao.id(), axis_attrib_idx, 1, GL_FLOAT, false, offsetof(Vertex, id));
+    glVertexArrayAttribBinding(m_vao.id(), axis_attrib_idx, 0);
 
     // setup y coord attribute
     GLuint y_coord_attrib_idx = 1;
-    glEnableVertexArrayAttrib(m_vao, y_coord_attrib_idx);
-    glVertexArrayAttribFormat(m_vao, y_coord_attrib_idx, 1, GL_FLOAT, false, offsetof(Vertex, attIndx));
-    glVertexArrayAttribBinding(m_vao, y_coord_attrib_idx, 0);
+    glEnableVertexArrayAttrib(m_vao.id(), y_coord_attrib_idx);
+    glVertexArrayAttribFormat(m_vao.id(), y_coord_attrib_idx, 1, GL_FLOAT, false, offsetof(Vertex, attIndx));
+    glVertexArrayAttribBinding(m_vao.id(), y_coord_attrib_idx, 0);
 
     m_vertices = std::vector<Vertex>{
 		Vertex{float(m_leftAxisIndex), 1.05f},
@@ -74,14 +70,17 @@ void ExpansionActive::initializeVertexBuffers() {
 		Vertex{float(m_rightAxisIndex), -1.05f}
 	};
 
-    glNamedBufferData(m_vbo, Utils::vectorsizeof(m_vertices), m_vertices.data(), GL_DYNAMIC_DRAW);
+    // vertex buffer binding is set on draw, the range may move within the pool
+    auto pool = m_linkedApp->getVertexPool();
+    m_vertex_range = pool->allocate(Utils::vectorsizeof(m_vertices), m_owner);
+    pool->write(m_vertex_range, m_vertices.data(), Utils::vectorsizeof(m_vertices));
 }
 
 void ExpansionActive::initializeIndexBuffer() {
     m_indicies = std::vector<unsigned short> {0,1,2,3};
-    glGenBuffers(1, &m_ibo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, Utils::vectorsizeof(m_indicies), m_indicies.data(), GL_STATIC_DRAW);
+    auto pool = m_linkedApp->getIndexPool();
+    m_index_range = pool->allocate(Utils::vectorsizeof(m_indicies), m_owner);
+    pool->write(m_index_range, m_indicies.data(), Utils::vectorsizeof(m_indicies));
 }
 
 void ExpansionActive::setActive(const bool& state) const {
@@ -5,6 +5,8 @@
 #include <spdlog/spdlog.h>
 #include <gl/program.hpp>
 #include <gl/shader.hpp>
+#include <gl/buffer_pool.hpp>
+#include <gl/resource.hpp>
 #include <functional>
 
 struct Vertex;
@@ -24,10 +26,9 @@ private:
     
     glm::mat4 m_model;
 	GLuint m_program;
-    GLuint m_vao;
-    GLuint m_vbo;
-    GLuint m_ibo;
-    GLuint m_axis_ssbo;
+    gl::VertexArray m_vao;
+    gl::BufferPool::Handle m_vertex_range;
+    gl::BufferPool::Handle m_index_range;
 
     std::vector<Vertex> m_vertices;
     std::vector<unsigned short> m_indicies;
@@ -38,6 +39,7 @@ private:
     int m_leftAxisIndex;
     int m_rightAxisIndex;
     bool m_active;
+    std::string m_owner; // name in resource registry
 
-    std::shared_ptr<GraphApp> m_linkedApp;
+    GraphApp* m_linkedApp;
 };
\ No newline at end of file
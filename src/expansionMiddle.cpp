@@ -8,31 +8,22 @@ ExpansionMiddle::ExpansionMiddle() {}
 ExpansionMiddle::ExpansionMiddle(const int& leftAxisIndex, const int& rightAxisIndex, const int& lineCount, const int& attributeCount, const GLuint& program, GraphApp* app) :
 	m_leftDepthIndex{0}, 
 	m_rightDepthIndex{0},
-	m_axis{std::vector<float>{-1, 1}},
     m_order{std::vector<int>{leftAxisIndex, rightAxisIndex}},
     m_lineCount{lineCount},
     m_attributeCount{attributeCount},
     m_program{program},
-    m_linkedApp{app}
+    m_linkedApp{app},
+    m_owner{fmt::format("ExpansionMiddle {}-{}", leftAxisIndex, rightAxisIndex)}
 {
-	initializeIndexBuffers();
     update();
 }
 
 ExpansionMiddle::~ExpansionMiddle() {
-    if (glIsBuffer(m_ibo)) {
-      glDeleteBuffers(1, &m_ibo);
+    for (const auto& segment : m_segments) {
+        m_linkedApp->getIndexPool()->release(segment.range);
     }
 }
 
-void ExpansionMiddle::initializeIndexBuffers() {
-    glGenBuffers(1, &m_ibo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
-    // allocate max possible space needed (all indicies -> normal view indecies)
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, Utils::vectorsizeof(*m_linkedApp->getIndicies()), NULL, GL_DYNAMIC_DRAW);
-    // glBufferData(GL_ELEMENT_ARRAY_BUFFER, Utils::vectorsizeof(m_indicies), m_indicies.data(), GL_DYNAMIC_DRAW);
-}
-
 void ExpansionMiddle::updateAxis(const std::vector<int>& axisIndicies) const {
     // return early if there is no actuall update
     auto prev = std::vector<int>{m_order.begin() + 1, m_order.end() - 1};
@@ -47,6 +38,19 @@ void ExpansionMiddle::updateAxis(const std::vector<int>& axisIndicies) const {
     update();
 }
 
+void ExpansionMiddle::setLineCount(const int& lineCount) {
+    // all segments are rewritten with the new count
+    if (lineCount == m_lineCount)
+        return;
+
+    for (const auto& segment : m_segments) {
+        m_linkedApp->getIndexPool()->release(segment.range);
+    }
+    m_segments.clear();
+    m_lineCount = lineCount;
+    update();
+}
+
 void ExpansionMiddle::update(const bool& init) const {
     /** funktion has to be called:
      *  1. to initialize middle
@@ -56,19 +60,36 @@ void ExpansionMiddle::update(const bool& init) const {
     **/   
 
     ExpansionMiddle* ptr = const_cast<ExpansionMiddle*>(this);
-    ptr->m_indicies.clear();
-
-    // add vertecies and indicies per line
-    for (unsigned short i = 0; i < m_lineCount * m_order.size(); i++) {
-        // add every indicie twice if it isnt start or endpoint of line
-        unsigned short idx = i / m_axis.size() * m_attributeCount + m_order[i % m_order.size()];
-        ptr->m_indicies.push_back(idx);
-        if (i % m_order.size() != 0 && i % m_order.size() != m_order.size() - 1) {
-            ptr->m_indicies.push_back(idx);
+    auto pool = m_linkedApp->getIndexPool();
+
+    // indicies are stored per segment, only segments of added axis are written
+    std::vector<Segment> segments;
+    for (int i = 0; i < m_order.size() - 1; i++) {
+        auto it = std::find_if(ptr->m_segments.begin(), ptr->m_segments.end(), [&](const Segment& s) {
+            return s.left == m_order[i] && s.right == m_order[i + 1];
+        });
+        if (it != ptr->m_segments.end()) {
+            segments.push_back(*it);
+            it->range = gl::BufferPool::INVALID_HANDLE;
+            continue;
         }
-    }
 
-    glNamedBufferSubData(m_ibo, 0, Utils::vectorsizeof(m_indicies), m_indicies.data());
+        // two indicies per line
+        std::vector<GLuint> indicies(m_lineCount * 2);
+        for (GLuint j = 0; j < m_lineCount; j++) {
+            indicies[j * 2] = j * m_attributeCount + m_order[i];
+            indicies[j * 2 + 1] = j * m_attributeCount + m_order[i + 1];
+        }
+        auto segment = Segment{m_order[i], m_order[i + 1], pool->allocate(Utils::vectorsizeof(indicies), m_owner)};
+        pool->write(segment.range, indicies.data(), Utils::vectorsizeof(indicies));
+        segments.push_back(segment);
+    }
+    
+    // free segments of removed axis
+    for (const auto& segment : m_segments) {
+        pool->release(segment.range);
+    }
+    ptr->m_segments = segments;
 }
 
 void ExpansionMiddle::draw() const {
@@ -77,14 +98,27 @@ void ExpansionMiddle::draw() const {
     gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "transform"), glm::scale(glm::mat4{1.0f}, glm::vec3{0.8f}));
     gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "to_range"), glm::vec2(-1, 1));
     glProgramUniform1i(m_program, glGetUniformLocation(m_program, "num_attributes"), m_linkedApp->getAxis()->size());
+    m_linkedApp->setDataFormatUniforms(m_program);
+
+    // pool ranges may move on compaction, look them up every draw
+    ExpansionMiddle* ptr = const_cast<ExpansionMiddle*>(this);
+    auto pool = m_linkedApp->getIndexPool();
+    auto& counts = ptr->m_draw_counts;
+    auto& offsets = ptr->m_draw_offsets;
+    counts.clear();
+    offsets.clear();
+    for (const auto& segment : m_segments) {
+        counts.push_back(m_lineCount * 2);
+        offsets.push_back((const void*)pool->offset(segment.range));
+    }
 
     // bind VAO with all vertecies in there
-    glBindVertexArray(*m_linkedApp->getVAO());
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
+    glBindVertexArray(m_linkedApp->getVAO());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool->id());
 
     // tell tesellation shader how many verts per line
     glPatchParameteri(GL_PATCH_VERTICES, 2);
 
     // uses buffer currently bound to GL_ELEMENT_ARRAY_BUFFER
-    glDrawElements(GL_PATCHES, m_indicies.size(), GL_UNSIGNED_SHORT, (const void*)0);
+    glMultiDrawElements(GL_PATCHES, counts.data(), GL_UNSIGNED_INT, offsets.data(), counts.size());
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <spdlog/spdlog.h>
 #include <gl/program.hpp>
 #include <gl/shader.hpp>
+#include <gl/buffer_pool.hpp>
 #include <functional>
 
 
@@ -19,21 +20,28 @@ public:
 	void update(const bool& init = false) const;
 	void draw() const;
     void updateAxis(const std::vector<int>& axisIndicies) const;
+    void setLineCount(const int& lineCount);
 
 private:
-    void initializeIndexBuffers();
-    
+    // lines between two neighbouring axis, all of them in one pool range
+    struct Segment {
+        int left;
+        int right;
+        gl::BufferPool::Handle range;
+    };
+
 	GLuint m_program;
-    GLuint m_ibo;
 
-	std::vector<float> m_axis;
 	std::vector<int> m_order;
-    std::vector<unsigned short> m_indicies;
+    std::vector<Segment> m_segments;
+    std::vector<GLsizei> m_draw_counts; // scratch for draw
+    std::vector<const void*> m_draw_offsets;
 	
 	int m_leftDepthIndex; // if 0, left handle between left axis [0,1], if 1 -> [1,2] ...
 	int m_rightDepthIndex; // if 0, left handle between left axis [0,1], if 1 -> [1,2] ...
 	int m_lineCount;
 	int m_attributeCount;
+    std::string m_owner; // name in resource registry
 
-	std::shared_ptr<GraphApp> m_linkedApp;
+	GraphApp* m_linkedApp;
 };
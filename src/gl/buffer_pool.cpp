@@ -0,0 +1,150 @@
+#include <gl/buffer_pool.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace gl {
+
+BufferPool::BufferPool(const std::string& owner, GLsizeiptr capacity, GLsizeiptr alignment)
+    : m_owner{owner}, m_capacity{0}, m_alignment{std::max<GLsizeiptr>(alignment, 1)}, m_used{0} {
+  reallocate(std::max<GLsizeiptr>(capacity, m_alignment));
+}
+
+BufferPool::Handle BufferPool::allocate(GLsizeiptr size, const std::string& owner) {
+  size = (std::max<GLsizeiptr>(size, 1) + m_alignment - 1) / m_alignment * m_alignment;
+
+  GLintptr offset = 0;
+  if (!find_free(size, offset)) {
+    // compacting is enough if the free space is only fragmented, otherwise grow
+    GLsizeiptr capacity = m_capacity;
+    if (m_capacity - m_used < size) {
+      capacity = std::max(m_capacity * 2, m_used + size);
+    }
+    reallocate(capacity);
+    find_free(size, offset);
+  }
+
+  auto range = Range{offset, size};
+  if (!owner.empty()) {
+    range.registration = Registration{owner, ResourceKind::POOL_RANGE, size};
+  }
+
+  Handle handle;
+  if (m_free_handles.empty()) {
+    handle = m_ranges.size();
+    m_ranges.push_back(std::move(range));
+  } else {
+    handle = m_free_handles.back();
+    m_free_handles.pop_back();
+    m_ranges[handle] = std::move(range);
+  }
+
+  m_used += size;
+  return handle;
+}
+
+void BufferPool::release(Handle handle) {
+  if (handle >= m_ranges.size() || m_ranges[handle].size == 0) {
+    return;
+  }
+
+  auto range = Range{m_ranges[handle].offset, m_ranges[handle].size};
+  m_ranges[handle] = Range{0, 0};
+  m_free_handles.push_back(handle);
+  m_used -= range.size;
+
+  // merge with the following and preceding free range
+  auto next = m_free.lower_bound(range.offset);
+  if (next != m_free.end() && next->first == range.offset + range.size) {
+    range.size += next->second;
+    next = m_free.erase(next);
+  }
+  if (next != m_free.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == range.offset) {
+      prev->second += range.size;
+      return;
+    }
+  }
+  m_free.emplace(range.offset, range.size);
+}
+
+void BufferPool::write(Handle handle, const void* data, GLsizeiptr size, GLintptr offset) {
+  const auto& range = m_ranges[handle];
+  if (offset + size > range.size) {
+    spdlog::error("Write of {} bytes at {} exceeds pool range of {} bytes", size, offset, range.size);
+    return;
+  }
+  glNamedBufferSubData(m_buffer.id(), range.offset + offset, size, data);
+}
+
+void BufferPool::compact() {
+  reallocate(m_capacity);
+}
+
+bool BufferPool::find_free(GLsizeiptr size, GLintptr& offset) {
+  for (auto it = m_free.begin(); it != m_free.end(); ++it) {
+    if (it->second < size) {
+      continue;
+    }
+    offset = it->first;
+    auto remaining = it->second - size;
+    m_free.erase(it);
+    if (remaining > 0) {
+      m_free.emplace(offset + size, remaining);
+    }
+    return true;
+  }
+  return false;
+}
+
+void BufferPool::reallocate(GLsizeiptr capacity) {
+  auto buffer = Buffer(m_owner, capacity, nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+  // copy live ranges packed to the front, in order of their old offset
+  std::vector<Handle> live(m_ranges.size());
+  std::iota(live.begin(), live.end(), 0);
+  live.erase(std::remove_if(live.begin(), live.end(), [&](Handle h) { return m_ranges[h].size == 0; }), live.end());
+  std::sort(live.begin(), live.end(), [&](Handle a, Handle b) { return m_ranges[a].offset < m_ranges[b].offset; });
+
+  GLintptr head = 0;
+  for (auto handle : live) {
+    auto& range = m_ranges[handle];
+    glCopyNamedBufferSubData(m_buffer.id(), buffer.id(), range.offset, head, range.size);
+    range.offset = head;
+    head += range.size;
+  }
+
+  m_free.clear();
+  if (head < capacity) {
+    m_free.emplace(head, capacity - head);
+  }
+
+  if (m_buffer.id() != 0) {
+    spdlog::debug("Buffer pool {} compacted to {} of {} bytes", m_owner, head, capacity);
+  }
+  m_buffer = std::move(buffer);
+  m_capacity = capacity;
+}
+
+GLuint BufferPool::id() const {
+  return m_buffer.id();
+}
+
+GLintptr BufferPool::offset(Handle handle) const {
+  return m_ranges[handle].offset;
+}
+
+GLsizeiptr BufferPool::size(Handle handle) const {
+  return m_ranges[handle].size;
+}
+
+GLsizeiptr BufferPool::capacity() const {
+  return m_capacity;
+}
+
+GLsizeiptr BufferPool::used() const {
+  return m_used;
+}
+
+}  // namespace gl
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gl/resource.hpp>
+
+namespace gl {
+
+// One buffer object shared by many small users. Ranges are handed out first-fit from a free list
+// and merged with their free neighbours on release. Compaction moves all live ranges to the front,
+// so users keep a handle and look up offset and buffer id at draw time.
+class BufferPool {
+ public:
+  using Handle = unsigned;
+  static const Handle INVALID_HANDLE = ~0u;
+
+  BufferPool(const std::string& owner, GLsizeiptr capacity, GLsizeiptr alignment = 4);
+  BufferPool(const BufferPool&) = delete;
+
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  // grows and compacts the buffer if there is no free range large enough,
+  // ranges with an owner are listed under its name in the resource registry
+  Handle allocate(GLsizeiptr size, const std::string& owner = "");
+  void release(Handle handle);
+  void write(Handle handle, const void* data, GLsizeiptr size, GLintptr offset = 0);
+  void compact();
+
+  GLuint id() const;
+  GLintptr offset(Handle handle) const;
+  GLsizeiptr size(Handle handle) const;
+  GLsizeiptr capacity() const;
+  GLsizeiptr used() const;
+
+ private:
+  struct Range {
+    GLintptr offset;
+    GLsizeiptr size;  // 0 -> handle unused
+    Registration registration;
+  };
+
+  bool find_free(GLsizeiptr size, GLintptr& offset);
+  void reallocate(GLsizeiptr capacity);
+
+  std::string m_owner;
+  Buffer m_buffer;
+  GLsizeiptr m_capacity;
+  GLsizeiptr m_alignment;
+  GLsizeiptr m_used;
+  std::vector<Range> m_ranges;          // indexed by handle
+  std::vector<Handle> m_free_handles;
+  std::map<GLintptr, GLsizeiptr> m_free;  // free ranges, offset -> size
+};
+
+}  // namespace gl
@@ -0,0 +1,208 @@
+#include <gl/call_counter.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <type_traits>
+
+namespace gl {
+
+namespace {
+
+thread_local CallCounts t_counts;
+thread_local GLuint t_program = 0;
+
+// replaces the glad pointer at SLOT with a wrapper that counts into COUNT before calling the driver
+template <auto* SLOT, uint64_t CallCounts::*COUNT, typename SIGNATURE = std::remove_pointer_t<decltype(SLOT)>>
+struct Counted;
+
+template <auto* SLOT, uint64_t CallCounts::*COUNT, typename R, typename... ARGS>
+struct Counted<SLOT, COUNT, R(APIENTRYP)(ARGS...)> {
+  static inline R(APIENTRYP driver)(ARGS...) = nullptr;
+
+  static R APIENTRY call(ARGS... args) {
+    t_counts.*COUNT += 1;
+    return driver(args...);
+  }
+
+  static void install() {
+    if (*SLOT && *SLOT != &call) {
+      driver = *SLOT;
+      *SLOT = &call;
+    }
+  }
+};
+
+#define COUNT_CALLS(NAME, COUNT) Counted<&glad_##NAME, &CallCounts::COUNT>::install()
+
+// calls counted by more than their number
+PFNGLDRAWARRAYSPROC driver_draw_arrays = nullptr;
+PFNGLDRAWELEMENTSPROC driver_draw_elements = nullptr;
+PFNGLUSEPROGRAMPROC driver_use_program = nullptr;
+PFNGLMULTIDRAWELEMENTSPROC driver_multi_draw_elements = nullptr;
+PFNGLMULTIDRAWARRAYSINDIRECTPROC driver_multi_draw_arrays_indirect = nullptr;
+PFNGLNAMEDBUFFERDATAPROC driver_named_buffer_data = nullptr;
+PFNGLNAMEDBUFFERSUBDATAPROC driver_named_buffer_sub_data = nullptr;
+PFNGLNAMEDBUFFERSTORAGEPROC driver_named_buffer_storage = nullptr;
+
+void APIENTRY draw_arrays(GLenum mode, GLint first, GLsizei count) {
+  t_counts.draws++;
+  t_counts.draw_commands++;
+  driver_draw_arrays(mode, first, count);
+}
+
+void APIENTRY draw_elements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+  t_counts.draws++;
+  t_counts.draw_commands++;
+  driver_draw_elements(mode, count, type, indices);
+}
+
+void APIENTRY use_program(GLuint program) {
+  t_counts.program_switches += program != t_program;
+  t_program = program;
+  driver_use_program(program);
+}
+
+void APIENTRY multi_draw_elements(GLenum mode, const GLsizei* count, GLenum type, const void* const* indices,
+                                  GLsizei drawcount) {
+  t_counts.draws++;
+  t_counts.draw_commands += drawcount;
+  driver_multi_draw_elements(mode, count, type, indices, drawcount);
+}
+
+void APIENTRY multi_draw_arrays_indirect(GLenum mode, const void* indirect, GLsizei drawcount, GLsizei stride) {
+  t_counts.draws++;
+  t_counts.draw_commands += drawcount;
+  driver_multi_draw_arrays_indirect(mode, indirect, drawcount, stride);
+}
+
+void APIENTRY named_buffer_data(GLuint buffer, GLsizeiptr size, const void* data, GLenum usage) {
+  t_counts.uploaded_bytes += data ? size : 0;
+  driver_named_buffer_data(buffer, size, data, usage);
+}
+
+void APIENTRY named_buffer_sub_data(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data) {
+  t_counts.uploaded_bytes += size;
+  driver_named_buffer_sub_data(buffer, offset, size, data);
+}
+
+void APIENTRY named_buffer_storage(GLuint buffer, GLsizeiptr size, const void* data, GLbitfield flags) {
+  t_counts.uploaded_bytes += data ? size : 0;
+  driver_named_buffer_storage(buffer, size, data, flags);
+}
+
+template <typename T>
+void wrap(T& slot, T& driver, T wrapper) {
+  if (slot && slot != wrapper) {
+    driver = slot;
+    slot = wrapper;
+  }
+}
+
+}  // namespace
+
+CallCounter& CallCounter::instance() {
+  static CallCounter counter;
+  return counter;
+}
+
+void CallCounter::install() {
+  if (m_installed) {
+    return;
+  }
+
+  COUNT_CALLS(glBindVertexArray, vertex_array_binds);
+  COUNT_CALLS(glBindBuffer, buffer_binds);
+  COUNT_CALLS(glBindBufferBase, buffer_binds);
+  COUNT_CALLS(glBindBufferRange, buffer_binds);
+  COUNT_CALLS(glVertexArrayVertexBuffer, buffer_binds);
+  COUNT_CALLS(glVertexArrayElementBuffer, buffer_binds);
+  COUNT_CALLS(glUniform1i, uniform_sets);
+  COUNT_CALLS(glUniform1f, uniform_sets);
+  COUNT_CALLS(glProgramUniform1i, uniform_sets);
+  COUNT_CALLS(glProgramUniform1f, uniform_sets);
+  COUNT_CALLS(glProgramUniform2iv, uniform_sets);
+  COUNT_CALLS(glProgramUniform3iv, uniform_sets);
+  COUNT_CALLS(glProgramUniform4iv, uniform_sets);
+  COUNT_CALLS(glProgramUniform2uiv, uniform_sets);
+  COUNT_CALLS(glProgramUniform3uiv, uniform_sets);
+  COUNT_CALLS(glProgramUniform4uiv, uniform_sets);
+  COUNT_CALLS(glProgramUniform2fv, uniform_sets);
+  COUNT_CALLS(glProgramUniform3fv, uniform_sets);
+  COUNT_CALLS(glProgramUniform4fv, uniform_sets);
+  COUNT_CALLS(glProgramUniform2dv, uniform_sets);
+  COUNT_CALLS(glProgramUniform3dv, uniform_sets);
+  COUNT_CALLS(glProgramUniform4dv, uniform_sets);
+  COUNT_CALLS(glProgramUniformMatrix2fv, uniform_sets);
+  COUNT_CALLS(glProgramUniformMatrix3fv, uniform_sets);
+  COUNT_CALLS(glProgramUniformMatrix4fv, uniform_sets);
+  COUNT_CALLS(glProgramUniformMatrix2dv, uniform_sets);
+  COUNT_CALLS(glProgramUniformMatrix3dv, uniform_sets);
+  COUNT_CALLS(glProgramUniformMatrix4dv, uniform_sets);
+
+  wrap(glad_glDrawArrays, driver_draw_arrays, &draw_arrays);
+  wrap(glad_glDrawElements, driver_draw_elements, &draw_elements);
+  wrap(glad_glUseProgram, driver_use_program, &use_program);
+  wrap(glad_glMultiDrawElements, driver_multi_draw_elements, &multi_draw_elements);
+  wrap(glad_glMultiDrawArraysIndirect, driver_multi_draw_arrays_indirect, &multi_draw_arrays_indirect);
+  wrap(glad_glNamedBufferData, driver_named_buffer_data, &named_buffer_data);
+  wrap(glad_glNamedBufferSubData, driver_named_buffer_sub_data, &named_buffer_sub_data);
+  wrap(glad_glNamedBufferStorage, driver_named_buffer_storage, &named_buffer_storage);
+
+  // primitives of a whole frame, read back once the query of a later frame is started
+  glCreateQueries(GL_PRIMITIVES_GENERATED, QUERY_COUNT, m_queries);
+  glBeginQuery(GL_PRIMITIVES_GENERATED, m_queries[m_head]);
+  m_pending[m_head] = true;
+  m_installed = true;
+}
+
+bool CallCounter::installed() const {
+  return m_installed;
+}
+
+void CallCounter::end_frame() {
+  if (!m_installed) {
+    return;
+  }
+  glEndQuery(GL_PRIMITIVES_GENERATED);
+
+  auto primitives = m_frame.primitives;
+  m_frame = t_counts;
+  t_counts = CallCounts{};
+
+  // oldest query finished QUERY_COUNT - 1 frames ago, rarely waits
+  m_head = (m_head + 1) % QUERY_COUNT;
+  if (m_pending[m_head]) {
+    GLuint64 generated = 0;
+    glGetQueryObjectui64v(m_queries[m_head], GL_QUERY_RESULT, &generated);
+    primitives = generated;
+  }
+  m_frame.primitives = primitives;
+
+  glBeginQuery(GL_PRIMITIVES_GENERATED, m_queries[m_head]);
+  m_pending[m_head] = true;
+}
+
+const CallCounts& CallCounter::frame() const {
+  return m_frame;
+}
+
+void CallCounter::report() const {
+  spdlog::info("Last frame: {} draws ({} commands), {} program switches, {} vertex array binds",
+               m_frame.draws, m_frame.draw_commands, m_frame.program_switches, m_frame.vertex_array_binds);
+  spdlog::info("    {} buffer binds, {} uniform sets, {:.1f} KB uploaded, {} primitives", m_frame.buffer_binds,
+               m_frame.uniform_sets, m_frame.uploaded_bytes / 1024.0, m_frame.primitives);
+}
+
+CallCounts CallCounter::current() {
+  return t_counts;
+}
+
+void CallCounter::reset() {
+  t_counts = CallCounts{};
+}
+
+void CallCounter::add_uploaded(GLsizeiptr bytes) {
+  t_counts.uploaded_bytes += bytes;
+}
+
+}  // namespace gl
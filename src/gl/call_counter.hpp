@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstdint>
+
+namespace gl {
+
+struct CallCounts {
+  uint64_t draws = 0;               // draw calls, a multi draw counts once
+  uint64_t draw_commands = 0;       // draws issued by those calls
+  uint64_t program_switches = 0;    // glUseProgram of another program than the bound one
+  uint64_t vertex_array_binds = 0;
+  uint64_t buffer_binds = 0;        // binding points and vertex array attachments
+  uint64_t uniform_sets = 0;
+  uint64_t uploaded_bytes = 0;      // buffer (sub) data and writes into mapped stream buffers
+  uint64_t primitives = 0;          // generated after tessellation, a few frames late
+};
+
+// Counts gl calls per frame by swapping glad's function pointers for counting wrappers, so every
+// call site is covered without changes. Counts are kept per thread and frames are closed on the
+// rendering thread, calls of loader threads are not included.
+class CallCounter {
+ public:
+  static CallCounter& instance();
+
+  // once glad is loaded, on the rendering thread
+  void install();
+  bool installed() const;
+  void end_frame();
+
+  // counts of the last closed frame
+  const CallCounts& frame() const;
+  void report() const;
+
+  // counts of the calling thread since its last end_frame() or reset(), for tests
+  static CallCounts current();
+  static void reset();
+
+  // writes into mapped memory aren't gl calls, their writers report them
+  static void add_uploaded(GLsizeiptr bytes);
+
+ private:
+  static const int QUERY_COUNT = 3;  // primitives are read back QUERY_COUNT - 1 frames late
+
+  CallCounter() = default;
+
+  bool m_installed = false;
+  GLuint m_queries[QUERY_COUNT] = {};
+  bool m_pending[QUERY_COUNT] = {};
+  int m_head = 0;
+  CallCounts m_frame;
+};
+
+}  // namespace gl
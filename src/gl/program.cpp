@@ -2,8 +2,11 @@
 
 namespace gl {
 
-GLuint create_program(const std::set<GLuint>& shaders) {
+GLuint create_program(const std::set<GLuint>& shaders, bool retrievable) {
   auto program = glCreateProgram();
+  if (retrievable) {
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
 
   // attach shaders
   for (auto shader : shaders) {
@@ -10,7 +10,7 @@
 
 namespace gl {
 
-GLuint create_program(const std::set<GLuint>& shaders);
+GLuint create_program(const std::set<GLuint>& shaders, bool retrievable = false);
 
 template <typename T>
 void set_program_uniform(GLuint program, GLint location, const T& value);
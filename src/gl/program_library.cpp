@@ -0,0 +1,172 @@
+#include <gl/program_library.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include <gl/program.hpp>
+#include <gl/shader.hpp>
+
+namespace gl {
+
+uint64_t hash_string(const std::string& value, uint64_t seed) {
+  // 64 bit FNV-1a
+  uint64_t hash = seed;
+  for (auto c : value) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+static std::string to_hex(uint64_t value) {
+  return fmt::format("{:016x}", value);
+}
+
+ProgramLibrary::ProgramLibrary(const std::string& cache_dir)
+    : m_cache_dir{cache_dir}, m_compiled{0}, m_linked{0}, m_loaded{0}, m_reused{0}, m_time_ms{0.0} {
+  // binaries are only valid for the exact driver they were created with
+  std::string driver;
+  for (auto name : {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION}) {
+    auto value = glGetString(name);
+    driver += value ? reinterpret_cast<const char*>(value) : "";
+  }
+  m_driver_key = to_hex(hash_string(driver));
+
+  GLint formats = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+  m_binaries_supported = formats > 0;
+
+  std::error_code error;
+  if (m_binaries_supported && !std::filesystem::create_directories(m_cache_dir, error) && error) {
+    spdlog::warn("Failed to create shader cache '{}': {}", m_cache_dir, error.message());
+    m_binaries_supported = false;
+  }
+}
+
+ProgramLibrary::~ProgramLibrary() {
+  for (auto& entry : m_shaders) {
+    glDeleteShader(entry.second);
+  }
+}
+
+GLuint ProgramLibrary::shader(const std::string& filename, const std::string& source, uint64_t hash) {
+  auto it = m_shaders.find(hash);
+  if (it != m_shaders.end()) {
+    return it->second;
+  }
+
+  GLuint shader = glCreateShader(detect_shader_type_from_filename(filename));
+  auto shader_cstring = source.c_str();
+  glShaderSource(shader, 1, &shader_cstring, nullptr);
+  if (!compile_shader(shader)) {
+    throw std::runtime_error("Failed to compile shader '" + filename + "'");
+  }
+
+  m_compiled++;
+  m_shaders[hash] = shader;
+  return shader;
+}
+
+GLuint ProgramLibrary::program(const std::vector<std::string>& filenames) {
+  auto start = std::chrono::steady_clock::now();
+
+  // key program by the content of all its stages
+  std::vector<std::string> sources;
+  std::vector<uint64_t> hashes;
+  uint64_t key = hash_string(m_driver_key);
+  for (const auto& filename : filenames) {
+    sources.push_back(load_shader_source_from_file(filename));
+    auto type = std::to_string(detect_shader_type_from_filename(filename));
+    hashes.push_back(hash_string(sources.back(), hash_string(type)));
+    key = hash_string(to_hex(hashes.back()), key);
+  }
+
+  auto it = m_programs.find(key);
+  if (it != m_programs.end()) {
+    m_reused++;
+    return it->second.id();
+  }
+
+  auto path = m_cache_dir + "/" + m_driver_key + "_" + to_hex(key) + ".bin";
+  GLuint program = 0;
+  if (m_binaries_supported) {
+    program = glCreateProgram();
+    if (load_binary(program, path)) {
+      m_loaded++;
+    } else {
+      glDeleteProgram(program);
+      program = 0;
+    }
+  }
+
+  // cache miss -> compile missing stages and link
+  if (program == 0) {
+    std::set<GLuint> shaders;
+    for (int i = 0; i < filenames.size(); i++) {
+      shaders.insert(shader(filenames[i], sources[i], hashes[i]));
+    }
+    program = create_program(shaders, m_binaries_supported);
+    m_linked++;
+
+    if (m_binaries_supported) {
+      store_binary(program, path);
+    }
+  }
+
+  m_programs.emplace(key, Program{"ProgramLibrary", program});
+  m_time_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return program;
+}
+
+bool ProgramLibrary::load_binary(GLuint program, const std::string& path) const {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  GLenum format = 0;
+  file.read(reinterpret_cast<char*>(&format), sizeof(format));
+  std::vector<char> binary(std::istreambuf_iterator<char>(file), {});
+  if (!file.eof() || binary.empty()) {
+    return false;
+  }
+
+  // driver may reject binaries e.g. after an update -> fall back to compiling
+  glProgramBinary(program, format, binary.data(), static_cast<GLsizei>(binary.size()));
+  GLint is_linked = GL_FALSE;
+  glGetProgramiv(program, GL_LINK_STATUS, &is_linked);
+  if (is_linked != GL_TRUE) {
+    spdlog::debug("Discarding outdated program binary '{}'", path);
+    return false;
+  }
+  return true;
+}
+
+void ProgramLibrary::store_binary(GLuint program, const std::string& path) const {
+  GLint length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+
+  GLenum format = 0;
+  std::vector<char> binary(length);
+  glGetProgramBinary(program, length, &length, &format, binary.data());
+
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+  file.write(binary.data(), length);
+  if (!file) {
+    spdlog::warn("Failed to write program binary '{}'", path);
+  }
+}
+
+void ProgramLibrary::report() const {
+  // warm start: every program came from the binary cache
+  bool warm = m_loaded > 0 && m_linked == 0;
+  spdlog::info("Shader programs ready in {:.1f} ms ({} start): {} loaded from cache, {} linked, {} shaders compiled, {} reused",
+               m_time_ms, warm ? "warm" : "cold", m_loaded, m_linked, m_compiled, m_reused);
+}
+
+}  // namespace gl
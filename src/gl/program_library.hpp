@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+
+#include <gl/resource.hpp>
+
+namespace gl {
+
+uint64_t hash_string(const std::string& value, uint64_t seed = 14695981039346656037ull);
+
+// Owns all shaders and programs of the application. Every shader source is compiled once per content
+// hash and every set of sources is linked once. Linked programs are written as program binaries to the
+// cache directory, keyed by driver and source hash, and loaded from there on later launches.
+class ProgramLibrary {
+ public:
+  ProgramLibrary(const std::string& cache_dir = "shader_cache");
+  ProgramLibrary(const ProgramLibrary&) = delete;
+  ~ProgramLibrary();
+
+  ProgramLibrary& operator=(const ProgramLibrary&) = delete;
+
+  // shader types are detected from the file endings
+  GLuint program(const std::vector<std::string>& filenames);
+  void report() const;
+
+ private:
+  GLuint shader(const std::string& filename, const std::string& source, uint64_t hash);
+  bool load_binary(GLuint program, const std::string& path) const;
+  void store_binary(GLuint program, const std::string& path) const;
+
+  std::string m_cache_dir;
+  std::string m_driver_key;
+  bool m_binaries_supported;
+
+  std::unordered_map<uint64_t, GLuint> m_shaders;
+  std::unordered_map<uint64_t, Program> m_programs;
+
+  // startup statistics
+  int m_compiled;
+  int m_linked;
+  int m_loaded;
+  int m_reused;
+  double m_time_ms;
+};
+
+}  // namespace gl
@@ -0,0 +1,105 @@
+#include <gl/resource.hpp>
+
+#include <utility>
+
+namespace gl {
+
+Buffer::Buffer(const std::string& owner, GLsizeiptr size, const void* data, GLbitfield flags)
+    : m_size{size}, m_registration{owner, ResourceKind::BUFFER, size} {
+  glCreateBuffers(1, &m_id);
+  glNamedBufferStorage(m_id, size, data, flags);
+}
+
+Buffer::Buffer(Buffer&& other) noexcept
+    : m_id{std::exchange(other.m_id, 0)},
+      m_size{std::exchange(other.m_size, 0)},
+      m_registration{std::move(other.m_registration)} {}
+
+Buffer::~Buffer() {
+  if (m_id != 0) {
+    glDeleteBuffers(1, &m_id);
+  }
+}
+
+Buffer& Buffer::operator=(Buffer&& other) noexcept {
+  if (this != &other) {
+    if (m_id != 0) {
+      glDeleteBuffers(1, &m_id);
+    }
+    m_id = std::exchange(other.m_id, 0);
+    m_size = std::exchange(other.m_size, 0);
+    m_registration = std::move(other.m_registration);
+  }
+  return *this;
+}
+
+GLuint Buffer::id() const {
+  return m_id;
+}
+
+GLsizeiptr Buffer::size() const {
+  return m_size;
+}
+
+VertexArray::VertexArray(const std::string& owner) : m_registration{owner, ResourceKind::VERTEX_ARRAY, 0} {
+  glCreateVertexArrays(1, &m_id);
+}
+
+VertexArray::VertexArray(VertexArray&& other) noexcept
+    : m_id{std::exchange(other.m_id, 0)}, m_registration{std::move(other.m_registration)} {}
+
+VertexArray::~VertexArray() {
+  if (m_id != 0) {
+    glDeleteVertexArrays(1, &m_id);
+  }
+}
+
+VertexArray& VertexArray::operator=(VertexArray&& other) noexcept {
+  if (this != &other) {
+    if (m_id != 0) {
+      glDeleteVertexArrays(1, &m_id);
+    }
+    m_id = std::exchange(other.m_id, 0);
+    m_registration = std::move(other.m_registration);
+  }
+  return *this;
+}
+
+GLuint VertexArray::id() const {
+  return m_id;
+}
+
+static GLsizeiptr program_size(GLuint program) {
+  GLint length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  return length;
+}
+
+Program::Program(const std::string& owner, GLuint program)
+    : m_id{program}, m_registration{owner, ResourceKind::PROGRAM, program_size(program)} {}
+
+Program::Program(Program&& other) noexcept
+    : m_id{std::exchange(other.m_id, 0)}, m_registration{std::move(other.m_registration)} {}
+
+Program::~Program() {
+  if (m_id != 0) {
+    glDeleteProgram(m_id);
+  }
+}
+
+Program& Program::operator=(Program&& other) noexcept {
+  if (this != &other) {
+    if (m_id != 0) {
+      glDeleteProgram(m_id);
+    }
+    m_id = std::exchange(other.m_id, 0);
+    m_registration = std::move(other.m_registration);
+  }
+  return *this;
+}
+
+GLuint Program::id() const {
+  return m_id;
+}
+
+}  // namespace gl
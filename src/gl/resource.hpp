@@ -0,0 +1,72 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <string>
+
+#include <gl/resource_registry.hpp>
+
+namespace gl {
+
+// Move-only owners of gl objects. Each one is registered with the ResourceRegistry under the name
+// of its owner and deleted on destruction.
+
+class Buffer {
+ public:
+  Buffer() = default;
+  // immutable storage, flags as for glNamedBufferStorage
+  Buffer(const std::string& owner, GLsizeiptr size, const void* data = nullptr, GLbitfield flags = 0);
+  Buffer(Buffer&& other) noexcept;
+  Buffer(const Buffer&) = delete;
+  ~Buffer();
+
+  Buffer& operator=(Buffer&& other) noexcept;
+  Buffer& operator=(const Buffer&) = delete;
+
+  GLuint id() const;
+  GLsizeiptr size() const;
+
+ private:
+  GLuint m_id = 0;
+  GLsizeiptr m_size = 0;
+  Registration m_registration;
+};
+
+class VertexArray {
+ public:
+  VertexArray() = default;
+  VertexArray(const std::string& owner);
+  VertexArray(VertexArray&& other) noexcept;
+  VertexArray(const VertexArray&) = delete;
+  ~VertexArray();
+
+  VertexArray& operator=(VertexArray&& other) noexcept;
+  VertexArray& operator=(const VertexArray&) = delete;
+
+  GLuint id() const;
+
+ private:
+  GLuint m_id = 0;
+  Registration m_registration;
+};
+
+class Program {
+ public:
+  Program() = default;
+  // takes ownership of a linked program, its size is estimated by its binary length
+  Program(const std::string& owner, GLuint program);
+  Program(Program&& other) noexcept;
+  Program(const Program&) = delete;
+  ~Program();
+
+  Program& operator=(Program&& other) noexcept;
+  Program& operator=(const Program&) = delete;
+
+  GLuint id() const;
+
+ private:
+  GLuint m_id = 0;
+  Registration m_registration;
+};
+
+}  // namespace gl
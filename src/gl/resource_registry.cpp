@@ -0,0 +1,153 @@
+#include <gl/resource_registry.hpp>
+
+#include <utility>
+
+namespace gl {
+
+static const char* kind_name(ResourceKind kind) {
+  switch (kind) {
+    case ResourceKind::BUFFER:
+      return "buffers";
+    case ResourceKind::VERTEX_ARRAY:
+      return "vertex arrays";
+    case ResourceKind::PROGRAM:
+      return "programs";
+    case ResourceKind::TEXTURE:
+      return "textures";
+    case ResourceKind::POOL_RANGE:
+      return "pool ranges";
+  }
+  return "";
+}
+
+static double to_mb(GLsizeiptr bytes) {
+  return bytes / (1024.0 * 1024.0);
+}
+
+ResourceRegistry& ResourceRegistry::instance() {
+  static ResourceRegistry registry;
+  return registry;
+}
+
+ResourceRegistry::Id ResourceRegistry::add(const std::string& owner, ResourceKind kind, GLsizeiptr bytes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto id = m_next_id++;
+  m_entries[id] = Entry{owner, kind, bytes};
+  check_budget(owner);
+  return id;
+}
+
+void ResourceRegistry::resize(Id id, GLsizeiptr bytes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(id);
+  if (it == m_entries.end()) {
+    return;
+  }
+  it->second.bytes = bytes;
+  check_budget(it->second.owner);
+}
+
+void ResourceRegistry::remove(Id id) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(id);
+  if (it == m_entries.end()) {
+    return;
+  }
+  auto owner = it->second.owner;
+  m_entries.erase(it);
+  check_budget(owner);
+}
+
+GLsizeiptr ResourceRegistry::bytes(const std::string& owner) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return bytes_unlocked(owner);
+}
+
+GLsizeiptr ResourceRegistry::total() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return bytes_unlocked("");
+}
+
+void ResourceRegistry::set_budget(const std::string& owner, GLsizeiptr bytes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_budgets[owner] = bytes;
+  m_exceeded.erase(owner);
+  check_budget(owner);
+}
+
+void ResourceRegistry::report() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // bytes and object count per owner and kind
+  std::map<std::string, std::map<ResourceKind, std::pair<GLsizeiptr, int>>> owners;
+  for (const auto& entry : m_entries) {
+    auto& usage = owners[entry.second.owner][entry.second.kind];
+    usage.first += entry.second.bytes;
+    usage.second++;
+  }
+
+  spdlog::info("GPU resources: {:.2f} MB in {} objects", to_mb(bytes_unlocked("")), m_entries.size());
+  for (const auto& owner : owners) {
+    std::string details;
+    for (const auto& usage : owner.second) {
+      details += fmt::format(", {} {} {:.2f} MB", usage.second.second, kind_name(usage.first), to_mb(usage.second.first));
+    }
+    spdlog::info("  {}: {:.2f} MB{}", owner.first, to_mb(bytes_unlocked(owner.first)), details);
+  }
+}
+
+GLsizeiptr ResourceRegistry::bytes_unlocked(const std::string& owner) const {
+  GLsizeiptr sum = 0;
+  for (const auto& entry : m_entries) {
+    if (entry.second.kind != ResourceKind::POOL_RANGE && (owner.empty() || entry.second.owner == owner)) {
+      sum += entry.second.bytes;
+    }
+  }
+  return sum;
+}
+
+void ResourceRegistry::check_budget(const std::string& owner) {
+  for (const auto& name : {owner, std::string()}) {
+    auto budget = m_budgets.find(name);
+    if (budget == m_budgets.end()) {
+      continue;
+    }
+
+    auto bytes = bytes_unlocked(name);
+    if (bytes <= budget->second) {
+      m_exceeded.erase(name);
+    } else if (m_exceeded.insert(name).second) {
+      spdlog::warn("GPU memory of {} exceeds budget: {:.2f} MB of {:.2f} MB", name.empty() ? "application" : name,
+                   to_mb(bytes), to_mb(budget->second));
+    }
+  }
+}
+
+Registration::Registration(const std::string& owner, ResourceKind kind, GLsizeiptr bytes)
+    : m_id{ResourceRegistry::instance().add(owner, kind, bytes)} {}
+
+Registration::Registration(Registration&& other) noexcept : m_id{std::exchange(other.m_id, 0)} {}
+
+Registration::~Registration() {
+  if (m_id != 0) {
+    ResourceRegistry::instance().remove(m_id);
+  }
+}
+
+Registration& Registration::operator=(Registration&& other) noexcept {
+  if (this != &other) {
+    if (m_id != 0) {
+      ResourceRegistry::instance().remove(m_id);
+    }
+    m_id = std::exchange(other.m_id, 0);
+  }
+  return *this;
+}
+
+void Registration::resize(GLsizeiptr bytes) {
+  if (m_id != 0) {
+    ResourceRegistry::instance().resize(m_id, bytes);
+  }
+}
+
+}  // namespace gl
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace gl {
+
+enum class ResourceKind { BUFFER, VERTEX_ARRAY, PROGRAM, TEXTURE, POOL_RANGE };
+
+// Bookkeeping of all live gpu objects and their sizes per owner. Owners are plain names like
+// "GraphApp" or "ExpansionMiddle 1-2". Pool ranges are listed per owner but not counted towards
+// totals and budgets, their memory already belongs to the pool buffer.
+class ResourceRegistry {
+ public:
+  using Id = size_t;
+
+  static ResourceRegistry& instance();
+
+  Id add(const std::string& owner, ResourceKind kind, GLsizeiptr bytes);
+  void resize(Id id, GLsizeiptr bytes);
+  void remove(Id id);
+
+  GLsizeiptr bytes(const std::string& owner) const;
+  GLsizeiptr total() const;
+
+  // warns whenever owner exceeds the budget, an empty owner sets the budget of the total
+  void set_budget(const std::string& owner, GLsizeiptr bytes);
+  void report() const;
+
+ private:
+  struct Entry {
+    std::string owner;
+    ResourceKind kind;
+    GLsizeiptr bytes;
+  };
+
+  ResourceRegistry() = default;
+  GLsizeiptr bytes_unlocked(const std::string& owner) const;
+  void check_budget(const std::string& owner);
+
+  mutable std::mutex m_mutex;
+  std::unordered_map<Id, Entry> m_entries;
+  std::map<std::string, GLsizeiptr> m_budgets;
+  std::set<std::string> m_exceeded;  // only warn once per crossing
+  Id m_next_id = 1;
+};
+
+// Move-only registry entry, removed from the registry on destruction.
+class Registration {
+ public:
+  Registration() = default;
+  Registration(const std::string& owner, ResourceKind kind, GLsizeiptr bytes);
+  Registration(Registration&& other) noexcept;
+  Registration(const Registration&) = delete;
+  ~Registration();
+
+  Registration& operator=(Registration&& other) noexcept;
+  Registration& operator=(const Registration&) = delete;
+
+  void resize(GLsizeiptr bytes);
+
+ private:
+  ResourceRegistry::Id m_id = 0;
+};
+
+}  // namespace gl
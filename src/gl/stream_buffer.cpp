@@ -0,0 +1,99 @@
+#include <gl/stream_buffer.hpp>
+
+#include <gl/call_counter.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace gl {
+
+StreamBuffer::StreamBuffer(const std::string& owner, GLsizeiptr capacity)
+    : m_capacity{std::max<GLsizeiptr>(capacity, 1)}, m_mapped{nullptr}, m_head{0}, m_written{false} {
+  // regions are bound with offsets, so they have to respect the strictest binding alignment
+  GLint ssbo_alignment = 1;
+  GLint ubo_alignment = 1;
+  glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &ssbo_alignment);
+  glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &ubo_alignment);
+  GLsizeiptr alignment = std::max({ssbo_alignment, ubo_alignment, 16});
+  m_stride = (m_capacity + alignment - 1) / alignment * alignment;
+
+  GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  m_buffer = Buffer(owner, m_stride * REGION_COUNT, nullptr, flags);
+  m_mapped = static_cast<char*>(glMapNamedBufferRange(m_buffer.id(), 0, m_stride * REGION_COUNT, flags));
+  if (!m_mapped) {
+    throw std::runtime_error("Failed to map stream buffer!");
+  }
+
+  for (auto& fence : m_fences) {
+    fence = nullptr;
+  }
+}
+
+StreamBuffer::~StreamBuffer() {
+  for (auto& fence : m_fences) {
+    if (fence) {
+      glDeleteSync(fence);
+    }
+  }
+  if (m_mapped) {
+    glUnmapNamedBuffer(m_buffer.id());
+  }
+}
+
+void StreamBuffer::wait(int region) {
+  if (!m_fences[region]) {
+    return;
+  }
+
+  // only blocks if the gpu is still REGION_COUNT - 1 writes behind
+  GLenum result = GL_TIMEOUT_EXPIRED;
+  while (result == GL_TIMEOUT_EXPIRED) {
+    result = glClientWaitSync(m_fences[region], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+  }
+  if (result == GL_WAIT_FAILED) {
+    spdlog::error("Waiting for stream buffer {} region {} failed", m_buffer.id(), region);
+  }
+
+  glDeleteSync(m_fences[region]);
+  m_fences[region] = nullptr;
+}
+
+void* StreamBuffer::map_next() {
+  // all commands reading the current region were issued already -> fence it
+  if (m_written) {
+    m_fences[m_head] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  }
+
+  m_head = (m_head + 1) % REGION_COUNT;
+  wait(m_head);
+  m_written = true;
+
+  return m_mapped + m_head * m_stride;
+}
+
+void StreamBuffer::write(const void* data, GLsizeiptr size) {
+  if (size > m_capacity) {
+    throw std::runtime_error("Stream buffer write exceeds capacity!");
+  }
+  std::memcpy(map_next(), data, size);
+  CallCounter::add_uploaded(size);
+}
+
+void StreamBuffer::bind_range(GLenum target, GLuint binding) const {
+  glBindBufferRange(target, binding, m_buffer.id(), offset(), m_capacity);
+}
+
+GLuint StreamBuffer::id() const {
+  return m_buffer.id();
+}
+
+GLintptr StreamBuffer::offset() const {
+  return m_head * m_stride;
+}
+
+GLsizeiptr StreamBuffer::capacity() const {
+  return m_capacity;
+}
+
+}  // namespace gl
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+
+#include <string>
+
+#include <gl/resource.hpp>
+
+namespace gl {
+
+// Persistently mapped buffer with immutable storage for dynamic uploads. The buffer is split into
+// REGION_COUNT regions, every write goes into the next region so the gpu can still read the previous
+// ones. A fence guards each region and is only waited on when the ring wraps around.
+class StreamBuffer {
+ public:
+  static const int REGION_COUNT = 3;
+
+  StreamBuffer(const std::string& owner, GLsizeiptr capacity);
+  StreamBuffer(const StreamBuffer&) = delete;
+  ~StreamBuffer();
+
+  StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+  // advance to the next region and return its mapped memory, previous content is not preserved
+  void* map_next();
+  template <typename T>
+  T* map_next() {
+    return static_cast<T*>(map_next());
+  }
+  void write(const void* data, GLsizeiptr size);
+
+  void bind_range(GLenum target, GLuint binding) const;
+
+  GLuint id() const;
+  GLintptr offset() const;
+  GLsizeiptr capacity() const;
+
+ private:
+  void wait(int region);
+
+  Buffer m_buffer;
+  GLsizeiptr m_capacity;  // usable bytes per region
+  GLsizeiptr m_stride;    // region size aligned for offset bindings
+  char* m_mapped;
+  GLsync m_fences[REGION_COUNT];
+  int m_head;
+  bool m_written;
+};
+
+}  // namespace gl
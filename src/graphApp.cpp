@@ -1,100 +1,582 @@
 #include<graphApp.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <filesystem>
+#include <numeric>
+#include <thread>
 
-GraphApp::GraphApp() : 
-    Application{}, 
-    m_num_attributes{4},
-    m_num_timeAxis{4},
+GraphApp::GraphApp(const Settings& settings) : 
+    Application{settings.headless}, 
+    m_programLibrary{settings.shaderCacheDir},
+    m_index_pool{"GraphApp index pool", 1 << 20, sizeof(GLuint)},
+    m_vertex_pool{"GraphApp vertex pool", 1 << 12, sizeof(Vertex)},
+    m_mapped_rows{0},
+    m_mapped_offset{0},
+    m_dataset{Dataset::open(settings.dataPath)},
+    m_num_attributes{int(m_dataset.columns.size())},
+    m_num_timeAxis{settings.timeSteps},
+    m_paged{settings.residentMb > 0 && m_dataset.format == DataFormat::COLUMNAR},
+    m_quantized{settings.quantize && !m_paged},
+    m_resident_bytes{size_t(settings.residentMb * 1024 * 1024)},
+    m_row_words{0},
+    m_visible_axes{settings.visibleAxes > 1 ? std::min(settings.visibleAxes, m_num_attributes) : m_num_attributes},
+    m_axis_first{0},
     m_model{glm::scale(glm::mat4{1.0f}, glm::vec3{0.8f})},
-    m_data{initializeData()}, // init for tools
+    m_loader{std::make_unique<DataLoader>(create_shared_context(), m_dataset, 4096)},
+    m_data{initializeData()}, // init for tools, first chunk only
     m_axis{initializeAxis()},  // init for tools
     m_ranges{initializeRanges()},  // init for tools
-    m_boxSelect_tool{new BoxSelect(this)},  // enable boxSelection tool
-    m_axisDrag_tool{new AxisDrag(this)},    // enable axisDrag tool
-    m_timeSeries_tool{new TimeSeries(this)} // enable timeSeries tool
+    m_layer_fbo{0},
+    m_layer_texture{0},
+    m_layer_dirty{true},
+    m_filter{settings.filter},
+    m_check_allocations{settings.checkAllocations},
+    m_frame_allocations{0},
+    m_progressive{settings.frameBudgetMs, 4096},
+    m_boxSelect_tool{std::make_unique<BoxSelect>(this)},  // enable boxSelection tool
+    m_axisDrag_tool{std::make_unique<AxisDrag>(this)},    // enable axisDrag tool
+    m_timeSeries_tool{std::make_unique<TimeSeries>(this, settings.visibleTimeSteps)}, // enable timeSeries tool
+    m_hover_tool{std::make_unique<HoverPick>(this)}, // enable line hovering
+    m_axisBrush_tool{std::make_unique<AxisBrush>(this)}, // enable axis range brushes
+    m_hover_id{-1}
 {     
+    if (settings.quantize && m_paged) {
+        spdlog::warn("Paged data is stored as floats, --quantize is ignored");
+    }
+    if (settings.residentMb > 0 && !m_paged) {
+        spdlog::warn("Only columnar files are paged, '{}' is kept resident (convert it with --convert)", m_dataset.path);
+    }
+    if (!settings.recordPath.empty()) {
+        record_input(settings.recordPath);
+    }
+    if (!settings.replayPath.empty()) {
+        replay_input(settings.replayPath);
+    }
+
     // setup shader program
-    auto vert_shader = gl::load_shader_from_file("shaders/polyline.vert", GL_VERTEX_SHADER);
-    auto tcs_shader = gl::load_shader_from_file("shaders/polyline.tesc", GL_TESS_CONTROL_SHADER);
-    auto tes_shader = gl::load_shader_from_file("shaders/polyline.tese", GL_TESS_EVALUATION_SHADER);
-    auto frag_shader = gl::load_shader_from_file("shaders/polyline.frag", GL_FRAGMENT_SHADER);
-    m_polyline_program = gl::create_program({vert_shader, tcs_shader, tes_shader, frag_shader});
+    m_polyline_program = m_programLibrary.program({
+        "shaders/polyline.vert", 
+        "shaders/polyline.tesc", 
+        "shaders/polyline.tese", 
+        "shaders/polyline.frag"
+    });
+    m_programLibrary.report();
     
     
     // init index stuff
     initializeIndexBuffer();
     initializeColor();        
 
+    // statistics of first time step, press 'O' to order axis by crossings ('Shift+O' by correlation)
+    m_stats = PairwiseStats{m_num_attributes};
+    m_stats.append(m_columns.view());
+    
+    // sorted rows per attribute, right drag on an axis brushes a value range
+    m_axis_index = AxisIndex{m_num_attributes};
+    m_axis_index.append(m_columns.view());
+
+    // stratified sample of the rows is drawn first, so a restarted base layer is a preview of all rows
+    int strata = settings.strataAttribute < 0 ? m_num_attributes - 1 : std::min(settings.strataAttribute, m_num_attributes - 1);
+    m_sample = StratifiedSample{m_num_attributes, strata, size_t(std::max(settings.previewRows, 0))};
+    m_sample.append(m_data.data(), m_columns.rows());
+    updateLineOrder();
+
     // init gpu buffers
     initializeVertexBuffers();
     initializeStorageBuffers();
     
     // activate color blending and setup background color
     m_clear_color = glm::vec3(0.125, 0.133, 0.156);
+    m_highlight_color = glm::vec4(1, 0, 0, 1);
+    m_hover_color = glm::vec4(1, 0.8, 0, 1);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glEnable(GL_BLEND);
+
+    // offscreen target for the static base polylines
+    initializeLayer();
+    
+    // wire up derived state, tools hook their own nodes in
+    initializeGraph();
+    m_timeSeries_tool->registerTool();
+    m_hover_tool->registerTool();
+    m_axisBrush_tool->registerTool();
+
+    // gpu memory per component, press 'M' for an updated report
+    if (settings.gpuBudgetMb > 0) {
+        gl::ResourceRegistry::instance().set_budget("", GLsizeiptr(settings.gpuBudgetMb * 1024 * 1024));
+    }
+    gl::ResourceRegistry::instance().report();
+
+    if (m_check_allocations && !AllocationCounter::enabled()) {
+        spdlog::warn("Allocation checks need a build with COUNT_ALLOCATIONS");
+    }
 }
 
 GraphApp::~GraphApp() {
-    if (glIsBuffer(m_vbo)) {
-        glDeleteBuffers(1, &m_vbo);
+    Scheduler::instance().wait(m_stats_task);
+    if (glIsFramebuffer(m_layer_fbo)) {
+        glDeleteFramebuffers(1, &m_layer_fbo);
     }
-    if (glIsVertexArray(m_vao)) {
-        glDeleteVertexArrays(1, &m_vao);
+    if (glIsTexture(m_layer_texture)) {
+        glDeleteTextures(1, &m_layer_texture);
     }
-    if (glIsBuffer(m_data_ssbo)) {
-        glDeleteBuffers(1, &m_data_ssbo);
+}
+
+bool GraphApp::draw() const {
+    Application::draw();
+    glEnable(GL_DEPTH_TEST);
+    
+    auto allocations = AllocationCounter::count();
+    auto prev_state = m_prevMouseState.state;
+    timed("loading", [this]() { updateLoading(); });
+    timed("input", [this]() { mouseEventListener(); });
+    
+    // recompute whatever the interaction invalidated, once
+    GraphApp* ptr = const_cast<GraphApp*>(this);
+    timed("graph", [ptr]() { ptr->m_graph.update(); });
+    ptr->m_moved_axis.clear();
+    
+    // re-render base polylines only if axes, ranges, data or base colors changed
+    timed("base layer", [this]() { updateBaseLayer(); });
+    glBlitNamedFramebuffer(m_layer_fbo, 0, 
+        0, 0, m_resolution.x, m_resolution.y, 
+        0, 0, m_resolution.x, m_resolution.y, 
+        GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    
+    // painters algo.: per frame layers on top of cached base layer
+    // both share same ssbos
+    timed("time series", [this]() { m_timeSeries_tool->draw(); });
+    // filtered base layer already shows only the selection
+    size_t selected = filtered() ? 0 : m_selection_ids.size();
+    bindPolyLines(m_selection_ibo->id(), true);
+    if (m_paged) {
+        drawPaged(m_selection_ibo->offset() / sizeof(GLuint), &m_selection_ids, selected, DrawRange{0, selected});
+    }
+    else {
+        drawPolyLines(DrawRange{
+            m_selection_ibo->offset() / sizeof(GLuint) + m_visible_segments.first * 2 * selected, 
+            m_visible_segments.count * 2 * selected
+        });
+    }
+    
+    // hovered line on top of the selection
+    if (m_hover_id >= 0) {
+        bindPolyLines(m_hover_ibo->id(), true);
+        gl::set_program_uniform(m_polyline_program, glGetUniformLocation(m_polyline_program, "highlight_color"), m_hover_color);
+        if (m_paged) {
+            ptr->m_block_pool.acquire(m_hover_id / m_block_pool.blockRows());
+        }
+        drawPolyLines(DrawRange{m_hover_ibo->offset() / sizeof(GLuint) + m_visible_segments.first * 2, m_visible_segments.count * 2});
     }
-    if (glIsBuffer(m_color_ssbo)) {
-        glDeleteBuffers(1, &m_color_ssbo);
+    
+    timed("axis drag", [this]() { m_axisDrag_tool->draw(); });
+    timed("axis brush", [this]() { m_axisBrush_tool->draw(); });
+    timed("box select", [this]() { m_boxSelect_tool->draw(); });
+    drawProgress();
+
+    // hovering and dragging shouldn't allocate once the first frame of an interaction is done
+    ptr->m_frame_allocations = AllocationCounter::count() - allocations;
+    auto state = m_prevMouseState.state;
+    bool steady = state == prev_state && (state == Drag || state == Default);
+    if (m_check_allocations && steady && m_frame_allocations > 0) {
+        spdlog::warn("{} heap allocations during steady interaction", m_frame_allocations);
+    }
+
+    return true;
+}
+
+void GraphApp::on_resize(int width, int height) {
+    Application::on_resize(width, height);
+    
+    // layer has to match default framebuffer for blitting
+    if (width > 0 && height > 0) {
+        initializeLayer();
+    }
+}
+
+void GraphApp::on_key(int key, int scancode, int action, int mods) {
+    Application::on_key(key, scancode, action, mods);
+    if (key == GLFW_KEY_M && action == GLFW_PRESS) {
+        gl::ResourceRegistry::instance().report();
+        if (m_paged) {
+            m_block_pool.report();
+        }
+    }
+    
+    // scroll axis viewport by one axis, zoom by showing one axis more or less
+    if (action == GLFW_PRESS || action == GLFW_REPEAT) {
+        if (key == GLFW_KEY_LEFT) {
+            setAxisViewport(m_axis_first - 1, m_visible_axes);
+        }
+        if (key == GLFW_KEY_RIGHT) {
+            setAxisViewport(m_axis_first + 1, m_visible_axes);
+        }
+        if (key == GLFW_KEY_UP) {
+            setAxisViewport(m_axis_first, m_visible_axes - 1);
+        }
+        if (key == GLFW_KEY_DOWN) {
+            setAxisViewport(m_axis_first, m_visible_axes + 1);
+        }
     }
-    if (glIsBuffer(m_range_ssbo)) {
-        glDeleteBuffers(1, &m_range_ssbo);
+    if (key == GLFW_KEY_P && action == GLFW_PRESS) {
+        // gl calls and state changes of the last frame
+        gl::CallCounter::instance().report();
     }
-    if (glIsBuffer(m_attribute_ssbo)) {
-        glDeleteBuffers(1, &m_attribute_ssbo);
+    if (key == GLFW_KEY_F && action == GLFW_PRESS) {
+        // hide unselected lines instead of highlighting selected ones
+        m_filter = !m_filter;
+        invalidateBaseLayer();
+        spdlog::info("Filter mode {}", m_filter ? "on" : "off");
     }
-    if (glIsBuffer(m_ibo)) {
-        glDeleteBuffers(1, &m_ibo);
+    if (key == GLFW_KEY_C && action == GLFW_PRESS) {
+        // load the next (previous) unused column of the file into the axis under the cursor
+        int attribute = m_axisBrush_tool->attributeAt(glm::vec2(m_mouse_pos));
+        if (attribute >= 0) {
+            swapColumn(attribute, mods & GLFW_MOD_SHIFT ? -1 : 1);
+        }
     }
-    if (glIsProgram(m_polyline_program)) {
-        glDeleteProgram(m_polyline_program);
-    } 
-    if (glIsProgram(m_axis_program)) {
-        glDeleteProgram(m_axis_program);
+    if (key == GLFW_KEY_O && action == GLFW_PRESS) {
+        auto metric = mods & GLFW_MOD_SHIFT ? OrderMetric::SPEARMAN : OrderMetric::CROSSINGS;
+        flushStatistics();
+        auto order = m_stats.solveOrder(metric);
+        m_stats.report();
+        m_axisDrag_tool->applyOrder(order);
     }
 }
 
-bool GraphApp::draw() const {
-    Application::draw();
-    glEnable(GL_DEPTH_TEST);
+void GraphApp::on_scroll(double x, double y) {
+    // pan visible time window of all expansions
+    m_timeSeries_tool->scrollTimeWindow(int(-y));
+    
+    // horizontal scrolling pans the axis viewport
+    if (x != 0) {
+        setAxisViewport(m_axis_first + float(x), m_visible_axes);
+    }
+}
 
-    mouseEventListener();
+void GraphApp::setAxisViewport(const float& first, const int& visible) {
+    /**
+     * Lays out axis in their current order on evenly spaced slots, 'visible'
+     * slots starting at 'first' fill [-1,1], all others land outside and their
+     * segments are culled. Manually dragged axis snap back onto their slot.
+    **/
     
-    // painters algo.: first background then foreground
-    m_axisDrag_tool->draw();
+    int num_axis = m_axis.size();
+    m_visible_axes = glm::clamp(visible, 2, num_axis);
+    m_axis_first = glm::clamp(first, 0.0f, float(num_axis - m_visible_axes));
     
-    // both share same ssbos
-    m_timeSeries_tool->draw();
-    drawPolyLines();
+    std::vector<float> axis(num_axis);
+    for (int i = 0; i < num_axis; i++) {
+        axis[m_axisOrder[i]] = Utils::remap((i - m_axis_first) / (m_visible_axes - 1), glm::vec2{0,1}, glm::vec2{-1,1});
+    }
+    m_axisDrag_tool->setAxis(axis);
+}
+
+void GraphApp::invalidateBaseLayer() const {
+    GraphApp* ptr = const_cast<GraphApp*>(this);
+    ptr->m_layer_dirty = true;
+}
+
+bool GraphApp::filtered() const {
+    return m_filter && !m_selection_ids.empty();
+}
+
+size_t GraphApp::baseLines() const {
+    return filtered() ? m_selection_ids.size() : m_colors.size();
+}
+
+void GraphApp::updateBaseLayer() const {
+    GraphApp* ptr = const_cast<GraphApp*>(this);
+    
+    // any change to the base image restarts accumulation
+    if (m_layer_dirty) {
+        auto clear_color = glm::vec4(m_clear_color, 1.0f);
+        glClearNamedFramebufferfv(m_layer_fbo, GL_COLOR, 0, glm::value_ptr(clear_color));
         
-    m_boxSelect_tool->draw();
+        // chunks only need to keep patches whole, paged data is drawn by lines
+        if (m_paged) {
+            ptr->m_progressive.restart(baseLines(), 1);
+        }
+        else {
+            ptr->m_progressive.restart(m_visible_segments.count * 2 * baseLines(), 2);
+        }
+        ptr->m_layer_dirty = false;
+    }
 
-    return true;
+    if (m_progressive.done()) {
+        return;
+    }
+
+    // draw as many line chunks as fit into the frame budget,
+    // filtering draws the compacted selection instead of all lines
+    GLuint ibo = filtered() ? m_selection_ibo->id() : m_ibo.id();
+    size_t base = filtered() ? m_selection_ibo->offset() / sizeof(GLuint) : 0;
+    glBindFramebuffer(GL_FRAMEBUFFER, m_layer_fbo);
+    bindPolyLines(ibo, false);
+    if (m_paged) {
+        const auto* ids = filtered() ? &m_selection_ids : nullptr;
+        ptr->m_progressive.render([this, base, ids](const DrawRange& range) {
+            drawPaged(base, ids, baseLines(), range);
+        });
+    }
+    else {
+        size_t first = base + m_visible_segments.first * 2 * baseLines();
+        ptr->m_progressive.render([this, first](const DrawRange& range) {
+            drawPolyLines(DrawRange{first + range.first, range.count});
+        });
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
     
+void GraphApp::updateLoading() const {
+    // one chunk per frame, chunks double in size so there are only a few
+    GraphApp* ptr = const_cast<GraphApp*>(this);
+    LoadedChunk chunk;
+    if (m_loader->poll(chunk)) {
+        ptr->appendRows(chunk);
+    }
+    ptr->updateStatistics();
+}
+
+void GraphApp::updateStatistics() {
+    // crossings of large chunks take a while -> background task, at most one at a time
+    if (!m_stats_task.done() || m_stats.rows() == m_columns.rows()) {
+        return;
+    }
+    
+    // the view only covers rows loaded so far, later appends don't touch them
+    auto columns = m_columns.view();
+    Scheduler::instance().submit([this, columns]() {
+        m_stats.append(columns);
+    }, m_stats_task, TaskPriority::BACKGROUND);
+}
+
+void GraphApp::flushStatistics() {
+    // ordering needs all loaded rows
+    Scheduler::instance().wait(m_stats_task);
+    m_stats.append(m_columns.view());
+}
+
+void GraphApp::appendRows(LoadedChunk& chunk) {
+    /**
+     * Rows of every time step are stored in one block per step, so all blocks 
+     * grow. The data ssbo is assembled on the gpu from the old buffer and the 
+     * staging buffer the loader uploaded. Everything derived from the rows 
+     * is recomputed through the rows node.
+    **/
+    
+    size_t num_axis = m_axis.size();
+    size_t old_lines = m_columns.rows();
+    size_t added = chunk.rows.size() / num_axis;
+    size_t lines = old_lines + added;
+    size_t old_block = old_lines * num_axis;
+    size_t block = lines * num_axis;
+    m_columns.append(chunk.rows.data(), added);
+    
+    // paged rows are read from the mapped file, the resident copy only exists to be uploaded
+    if (!m_paged) {
+        std::vector<float> data(block * m_num_timeAxis);
+        for (int t = 0; t < m_num_timeAxis; t++) {
+            std::copy(m_data.begin() + t * old_block, m_data.begin() + (t + 1) * old_block, data.begin() + t * block);
+            std::copy(chunk.rows.begin(), chunk.rows.end(), data.begin() + t * block + old_block);
+        }
+        m_data.swap(data);
+    }
+    
+    // ranges only widen
+    auto old_ranges = m_ranges;
+    for (size_t i = 0; i < chunk.rows.size(); i++) {
+        auto& range = m_ranges[i % num_axis];
+        range = glm::vec2(glm::min(range.x, chunk.rows[i]), glm::max(range.y, chunk.rows[i]));
+    }
+    bool widened = m_ranges != old_ranges;
+    glNamedBufferSubData(m_range_ssbo.id(), 0, Utils::vectorsizeof(m_ranges), m_ranges.data());
+
+    // quantization depends on the ranges and on the bits per attribute -> requantize all rows if either 
+    // changed, otherwise only the new rows are quantized and the old words are copied on the gpu
+    if (m_quantized && (widened || !Utils::extendLayout(m_quantization, chunk.rows))) {
+        uploadData();
+    }
+    else if (m_quantized) {
+        auto words = Utils::quantizeRows(chunk.rows, m_ranges, m_quantization);
+        size_t old_words = old_lines * m_row_words;
+        size_t block_words = lines * m_row_words;
+        gl::Buffer data_ssbo("GraphApp", block_words * m_num_timeAxis * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+        for (int t = 0; t < m_num_timeAxis; t++) {
+            glCopyNamedBufferSubData(m_data_ssbo.id(), data_ssbo.id(), t * old_words * sizeof(GLuint), t * block_words * sizeof(GLuint), old_words * sizeof(GLuint));
+            glNamedBufferSubData(data_ssbo.id(), (t * block_words + old_words) * sizeof(GLuint), Utils::vectorsizeof(words), words.data());
+        }
+        m_data_ssbo = std::move(data_ssbo);
+        bindData();
+    }
+    else if (m_paged) {
+        // later time steps moved -> every block is refilled on demand
+        m_block_pool.resize(lines * m_num_timeAxis);
+        bindData();
+    }
+    else {
+        gl::Buffer data_ssbo("GraphApp", Utils::vectorsizeof(m_data));
+        for (int t = 0; t < m_num_timeAxis; t++) {
+            glCopyNamedBufferSubData(m_data_ssbo.id(), data_ssbo.id(), t * old_block * sizeof(float), t * block * sizeof(float), old_block * sizeof(float));
+            glCopyNamedBufferSubData(chunk.staging.id(), data_ssbo.id(), 0, (t * block + old_block) * sizeof(float), Utils::vectorsizeof(chunk.rows));
+        }
+        m_data_ssbo = std::move(data_ssbo);
+        bindData();
+    }
+    
+    // per line colors
+    initializeColor();
+    m_color_ssbo = gl::Buffer("GraphApp", Utils::vectorsizeof(m_colors), m_colors.data(), GL_DYNAMIC_STORAGE_BIT);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_color_ssbo.id());
+    
+    // index buffer only has space for the previous rows, selections can't grow with the rows
+    size_t capacity = (num_axis - 1) * 2 * indexLines() * sizeof(GLuint);
+    m_ibo = gl::Buffer("GraphApp", capacity, nullptr, GL_DYNAMIC_STORAGE_BIT);
+    
+    m_axis_index.append(m_columns.view());
+    m_sample.append(chunk.rows.data(), added);
+    updateLineOrder();
+    m_graph.markDirty(m_rows_node);
+    
+    spdlog::info("Loaded {} rows ({:.0f}%)", lines, 100 * m_loader->progress());
+}
+
+void GraphApp::swapColumn(const int& attribute, const int& step) {
+    /**
+     * Columns that aren't shown are loaded on demand, only the new column is 
+     * read (no other I/O for columnar files). Everything derived from the 
+     * rows is rebuilt through the rows node.
+    **/
+
+    if (loading()) {
+        spdlog::warn("Columns can only be swapped once loading finished");
+        return;
+    }
+    int column = m_dataset.nextUnused(m_dataset.columns[attribute], step);
+    if (column < 0) {
+        return;
+    }
+    
+    size_t lines = m_columns.rows();
+    auto values = m_dataset.readColumn(column);
+    if (values.size() != lines) {
+        spdlog::warn("Column '{}' isn't numeric in every row", m_dataset.names[column]);
+        return;
+    }
+    m_dataset.columns[attribute] = column;
+    
+    // pairs with this attribute are stale, statistics are rebuilt in the background.
+    // Only the running task has to finish, pending rows would be counted for nothing
+    Scheduler::instance().wait(m_stats_task);
+    
+    // same values in every time step, paged blocks read the new column from the mapped file
+    auto range = glm::vec2(values[0]);
+    for (size_t r = 0; r < lines; r++) {
+        range = glm::vec2(glm::min(range.x, values[r]), glm::max(range.y, values[r]));
+    }
+    if (m_paged) {
+        auto columns = reinterpret_cast<const float*>(m_mapping->data() + m_mapped_offset);
+        m_columns.map(attribute, columns + column * m_mapped_rows);
+    }
+    else {
+        for (int t = 0; t < m_num_timeAxis; t++) {
+            for (size_t r = 0; r < lines; r++) {
+                m_data[(t * lines + r) * m_num_attributes + attribute] = values[r];
+            }
+        }
+        m_columns.assign(attribute, values);
+    }
+    m_ranges[attribute] = range;
+    glNamedBufferSubData(m_range_ssbo.id(), 0, Utils::vectorsizeof(m_ranges), m_ranges.data());
+    uploadData();
+
+    m_stats = PairwiseStats{m_num_attributes};
+    m_axis_index = AxisIndex{m_num_attributes};
+    m_axis_index.append(m_columns.view());
+    m_sample.reset();
+    // the sample takes row major rows, handed over a block at a time
+    for (size_t first = 0; first < lines; first += ColumnStore::BLOCK_ROWS) {
+        size_t count = std::min(ColumnStore::BLOCK_ROWS, lines - first);
+        std::vector<float> rows(count * m_num_attributes);
+        for (size_t r = 0; r < count; r++) {
+            for (int a = 0; a < m_num_attributes; a++) {
+                rows[r * m_num_attributes + a] = m_columns.value(a, first + r);
+            }
+        }
+        m_sample.append(rows.data(), count);
+    }
+    updateLineOrder();
+    m_axisBrush_tool->removeBrush(attribute);
+    // row count is unchanged, the pyramid can't tell it is stale
+    m_timeSeries_tool->invalidatePyramid();
+    m_graph.markDirty(m_rows_node);
+
+    spdlog::info("Axis {} shows column '{}'", attribute, m_dataset.names[column]);
+}
+
+void GraphApp::updateLineOrder() {
+    // paged drawing needs lines in row order to draw whole blocks
+    if (m_paged) {
+        return;
+    }
+    m_line_order = m_sample.order(m_columns.rows());
+    
+    // once all rows are there, not for every chunk
+    if (!loading()) {
+        m_sample.report();
+    }
+}
+
+void GraphApp::drawProgress() const {
+    if (!loading()) {
+        return;
+    }
+
+    // plain bar along the bottom edge, scissored clear needs no resources
+    GLsizei width = GLsizei(m_resolution.x * m_loader->progress());
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, 0, width, 4);
+    glClearColor(m_highlight_color.r, m_highlight_color.g, m_highlight_color.b, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glDisable(GL_SCISSOR_TEST);
+}
+
 std::vector<float> GraphApp::initializeData() {
-    std::vector<float> tmp;
+    // only the first (small) chunk is waited for, the rest streams in while rendering
+    LoadedChunk chunk;
+    while (!m_loader->poll(chunk)) {
+        if (m_loader->done()) {
+            throw std::runtime_error("Failed to initialze data!");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::vector<float> tmp = std::move(chunk.rows);
     
-    // Utils::readData(tmp, "../../iris.txt", false, true);
-    Utils::readData(tmp, "../iris.txt", false, true);
-    // Utils::readData(tmp, "../../sea-ice-extent-annually.csv", true, false);
-    // Utils::readData(tmp, "../../sea-ice-extent.csv", true, false);
+    // columns of first time step, read by the statistics, the axis index and the tools.
+    // Paged rows stay in the mapped file, only the first chunk is kept for initialization
+    if (m_paged) {
+        ColumnarFile file(m_dataset.path);
+        m_mapped_rows = file.rows();
+        m_mapped_offset = file.dataOffset();
+        m_mapping = std::make_unique<MappedFile>(m_dataset.path);
+        auto columns = reinterpret_cast<const float*>(m_mapping->data() + m_mapped_offset);
+        std::vector<const float*> mapped;
+        for (const auto& column : m_dataset.columns) {
+            mapped.push_back(columns + column * m_mapped_rows);
+        }
+        m_columns = ColumnStore{mapped};
+    }
+    else {
+        m_columns = ColumnStore{m_num_attributes};
+    }
+    m_columns.append(tmp.data(), tmp.size() / m_num_attributes);
     
     // replace with actual time data
     // appending same data over and over again
+    // (inserting a vector into itself is undefined -> copy into resized storage)
     int size = tmp.size();
-    for (int i = 0; i < m_num_timeAxis - 1; i++) {
-        tmp.insert(tmp.end(), tmp.begin(), tmp.begin() + size);
+    tmp.resize(size * m_num_timeAxis);
+    for (int i = 1; i < m_num_timeAxis; i++) {
+        std::copy(tmp.begin(), tmp.begin() + size, tmp.begin() + i * size);
     }
     
     spdlog::debug("data size {}", tmp.size());
@@ -131,7 +613,7 @@ void GraphApp::initializeColor() {
         throw std::runtime_error("Failed to initialze Color data!");
     }
     m_colors.clear();
-    for (int i = 0; i < (m_data.size() / m_num_timeAxis) / m_axis.size(); i++) {
+    for (int i = 0; i < m_columns.rows(); i++) {
         if(i < 50)
             m_colors.push_back(glm::vec4(0.321, 0.580, 0.886, 0.4f));
         else if(i >= 50 && i < 100)
@@ -142,71 +624,115 @@ void GraphApp::initializeColor() {
 }
 
 std::vector<float> GraphApp::initializeAxis() {
+    // first 'm_visible_axes' axis span the window, remaining ones continue to the right
     std::vector<float> tmp(m_num_attributes, 0);
     for (int i = 0; i < m_num_attributes; i++) {
-        tmp[i] = Utils::remap((float)i / (m_num_attributes - 1), glm::vec2{0,1}, glm::vec2{-1,1});
+        tmp[i] = Utils::remap((float)i / (m_visible_axes - 1), glm::vec2{0,1}, glm::vec2{-1,1});
     }
     return tmp;
 }
 
 void GraphApp::initializeVertexBuffers() {
     /**
-    *   Only passing in floats since int and uint seems to have padding / offset errors.
-    *   ID and AttribueIndex are casted to int in shader           
+    *   No vertex attributes: index (line * axis + attribute) of a value is all 
+    *   the shaders need, they split gl_VertexID back into both. Drawing in a 
+    *   core profile still needs a vertex array object bound.
     */
         
-    // setup vertex array object and vertex buffer
-    glCreateVertexArrays(1, &m_vao);
-    glCreateBuffers(1, &m_vbo);
-    glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, sizeof(Vertex));
-    
-    // setup value id attribute
-    GLuint id_attrib_idx = 0;
-    glEnableVertexArrayAttrib(m_vao, id_attrib_idx);
-    glVertexArrayAttribFormat(m_vao, id_attrib_idx, 1, GL_FLOAT, false, offsetof(Vertex, id));
-    glVertexArrayAttribBinding(m_vao, id_attrib_idx, 0);
-
-    // setup attribute index id attribute
-    GLuint att_attrib_idx = 1;
-    glEnableVertexArrayAttrib(m_vao, att_attrib_idx);
-    glVertexArrayAttribFormat(m_vao, att_attrib_idx, 1, GL_FLOAT, false, offsetof(Vertex, attIndx));
-    glVertexArrayAttribBinding(m_vao, att_attrib_idx, 0);
-
-    // setup vertices
-    for (int i = 0; i < m_data.size() / m_num_timeAxis; i++) {
-        m_vertices.push_back( Vertex{
-            float(i / m_axis.size()),
-            float(i % m_axis.size())
-        });
-    }
-
-    glNamedBufferData(m_vbo, Utils::vectorsizeof(m_vertices), m_vertices.data(), GL_DYNAMIC_DRAW);
+    m_vao = gl::VertexArray{"GraphApp"};
 }
     
 void GraphApp::initializeStorageBuffers() {         
-    // setup data ssbo
-    GLuint data_binding = 0;
-	glCreateBuffers(1, &m_data_ssbo);
-	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, data_binding, m_data_ssbo);
-	glNamedBufferData(m_data_ssbo, Utils::vectorsizeof(m_data), m_data.data(), GL_DYNAMIC_DRAW);
+    uploadData();
              
     // setup color ssbo
     GLuint color_binding = 1;
-	glCreateBuffers(1, &m_color_ssbo);
-	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, color_binding, m_color_ssbo);
-	glNamedBufferData(m_color_ssbo, Utils::vectorsizeof(m_colors), m_colors.data(), GL_DYNAMIC_DRAW);
-        
+	m_color_ssbo = gl::Buffer("GraphApp", Utils::vectorsizeof(m_colors), m_colors.data(), GL_DYNAMIC_STORAGE_BIT);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, color_binding, m_color_ssbo.id());
+
     // setup attribute ranges ssbo
     GLuint range_binding = 2;
-	glCreateBuffers(1, &m_range_ssbo);
-	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, range_binding, m_range_ssbo);
-	glNamedBufferData(m_range_ssbo, Utils::vectorsizeof(m_ranges), m_ranges.data(), GL_DYNAMIC_DRAW);
+	m_range_ssbo = gl::Buffer("GraphApp", Utils::vectorsizeof(m_ranges), m_ranges.data(), GL_DYNAMIC_STORAGE_BIT);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, range_binding, m_range_ssbo.id());
 
-    // setup attribute axis pos (x-coord) ssbo
+    // setup attribute axis pos (x-coord) ssbo, moved every axis drag -> streamed
     GLuint attribute_pos_binding = 3;
-	glCreateBuffers(1, &m_attribute_ssbo);
-	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, attribute_pos_binding, m_attribute_ssbo);
-	glNamedBufferData(m_attribute_ssbo, Utils::vectorsizeof(m_axis), m_axis.data(), GL_DYNAMIC_DRAW);
+	m_attribute_ssbo = std::make_unique<gl::StreamBuffer>("GraphApp", Utils::vectorsizeof(m_axis));
+	m_attribute_ssbo->write(m_axis.data(), Utils::vectorsizeof(m_axis));
+	m_attribute_ssbo->bind_range(GL_SHADER_STORAGE_BUFFER, attribute_pos_binding);
+}
+
+void GraphApp::uploadData() {
+    // setup data ssbo, either raw floats or values quantized against their ranges
+    // setup quantization ssbo, dequantization maps straight into to_range of the shaders
+    GLuint quantization_binding = 5;
+    if (m_paged) {
+        // budget decides how many blocks are resident, their rows are filled on demand.
+        // Colors of all lines and the indices of one block are resident too and come off the budget first
+        size_t block_rows = pagedBlockRows();
+        size_t block_bytes = block_rows * m_num_attributes * sizeof(float);
+        size_t fixed_bytes = m_mapped_rows * sizeof(glm::vec4) + (m_num_attributes - 1) * 2 * block_rows * sizeof(GLuint);
+        if (fixed_bytes + block_bytes > m_resident_bytes) {
+            spdlog::warn("Colors and indices take {:.1f} MB of the {:.1f} MB resident budget, only one block fits", 
+                fixed_bytes / (1024.0 * 1024.0), m_resident_bytes / (1024.0 * 1024.0));
+        }
+        size_t slots = std::max<size_t>((m_resident_bytes - std::min(fixed_bytes, m_resident_bytes)) / block_bytes, 1);
+        m_block_pool = RowBlockPool(block_rows, m_num_attributes, slots, 
+            [this](const size_t& first, const size_t& count, float* rows) { fillRows(first, count, rows); },
+            [this](const size_t& first, const size_t& count) { prefetchRows(first, count); });
+        m_block_pool.resize(m_columns.rows() * m_num_timeAxis);
+	    m_quantization_ssbo = gl::Buffer("GraphApp", sizeof(QuantizedAttribute));
+    }
+    else if (m_quantized) {
+        // layout is kept to quantize appended rows on their own
+        m_quantization = Utils::quantizeData(m_data, m_ranges, glm::vec2(-1, 1));
+        m_row_words = m_quantization.rowWords;
+	    m_data_ssbo = gl::Buffer("GraphApp", Utils::vectorsizeof(m_quantization.words), m_quantization.words.data());
+	    m_quantization_ssbo = gl::Buffer("GraphApp", Utils::vectorsizeof(m_quantization.attributes), m_quantization.attributes.data());
+        m_quantization.words = {};
+    }
+    else {
+	    m_data_ssbo = gl::Buffer("GraphApp", Utils::vectorsizeof(m_data), m_data.data());
+	    m_quantization_ssbo = gl::Buffer("GraphApp", sizeof(QuantizedAttribute));
+    }
+	bindData();
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, quantization_binding, m_quantization_ssbo.id());
+}
+
+void GraphApp::bindData() const {
+    // paged data lives in the slots of the block pool, its table is bound either way
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_data_ssbo.id());
+    m_block_pool.bind(0, 8);
+}
+
+void GraphApp::fillRows(const size_t& first, const size_t& count, float* rows) const {
+    // rows of all time steps one after another, time steps repeat the rows of the file
+    size_t num = m_num_attributes;
+    size_t lines = m_columns.rows();
+    auto columns = reinterpret_cast<const float*>(m_mapping->data() + m_mapped_offset);
+    for (size_t i = 0; i < count; i++) {
+        size_t row = (first + i) % lines;
+        for (size_t a = 0; a < num; a++) {
+            rows[i * num + a] = columns[m_dataset.columns[a] * m_mapped_rows + row];
+        }
+    }
+}
+
+size_t GraphApp::pagedBlockRows() const {
+    return std::max<size_t>(BLOCK_BYTES / (m_num_attributes * sizeof(float)), 1);
+}
+
+size_t GraphApp::indexLines() const {
+    // paged lines are drawn a block at a time, every block reuses the indices of the first one
+    return m_paged ? pagedBlockRows() : m_columns.rows();
+}
+
+void GraphApp::prefetchRows(const size_t& first, const size_t& count) const {
+    // only the projected columns of the mapped file are read ahead
+    size_t row = first % m_columns.rows();
+    for (const auto& column : m_dataset.columns) {
+        m_mapping->prefetch(m_mapped_offset + (column * m_mapped_rows + row) * sizeof(float), count * sizeof(float));
+    }
 }
     
 void GraphApp::initializeIndexBuffer() {
@@ -215,43 +741,165 @@ void GraphApp::initializeIndexBuffer() {
         throw std::runtime_error("Failed to initialze Color data!");
     }
         
-    // tes-schader can't do linestrips -> push all vertex indicies 
-    // in twice except for first and last of each line 
-    for (unsigned short i = 0; i < m_data.size() / m_num_timeAxis; i++) {
-        m_indicies.push_back(i);
-        if (i % m_num_attributes != 0 && i % m_num_attributes != m_num_attributes - 1) {
-            m_indicies.push_back(i);
-        }
+    // tes-schader can't do linestrips -> every segment has its own 2 indicies,
+    // nothing excluded yet so all axis-1 segments are present
+    size_t capacity = (m_axis.size() - 1) * 2 * indexLines() * sizeof(GLuint);
+    
+    // Bind to Element array buffer -> Indexing so DrawElements can be used
+    // only rewritten on axis reorder / exclusion, a ring of full copies isn't worth it
+    m_ibo = gl::Buffer("GraphApp", capacity, nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+    // rewritten every brushing frame -> streamed, sized by the selection and grown on demand
+    reserveSelection(0);
+    m_selection_count = 0;
+    m_hover_ibo = std::make_unique<gl::StreamBuffer>("GraphApp", (m_axis.size() - 1) * 2 * sizeof(GLuint));
+    
+    // axis in initial order
+    m_axisOrder.resize(m_axis.size());
+    std::iota(m_axisOrder.begin(), m_axisOrder.end(), 0);
+    updateVertexIndicies();
+    updateVisibleSegments();
+}
+
+void GraphApp::initializeLayer() {
+    // (re-)create color target in window resolution, old one is dropped on resize
+    if (glIsFramebuffer(m_layer_fbo)) {
+        glDeleteFramebuffers(1, &m_layer_fbo);
+    }
+    if (glIsTexture(m_layer_texture)) {
+        glDeleteTextures(1, &m_layer_texture);
     }
 
-    // Bind to Element array buffer -> Indexing so DrawElements can be used
-    glGenBuffers(1, &m_ibo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, Utils::vectorsizeof(m_indicies), m_indicies.data(), GL_DYNAMIC_DRAW);
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_layer_texture);
+    glTextureStorage2D(m_layer_texture, 1, GL_RGBA8, m_resolution.x, m_resolution.y);
+    m_layer_registration = gl::Registration{"GraphApp", gl::ResourceKind::TEXTURE, GLsizeiptr(m_resolution.x) * m_resolution.y * 4};
+    
+    glCreateFramebuffers(1, &m_layer_fbo);
+    glNamedFramebufferTexture(m_layer_fbo, GL_COLOR_ATTACHMENT0, m_layer_texture, 0);
+    
+    if (glCheckNamedFramebufferStatus(m_layer_fbo, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        throw std::runtime_error("Failed to initialze base layer framebuffer!");
+    }
+
+    invalidateBaseLayer();
+}
+
+void GraphApp::initializeGraph() {
+    // inputs, set by tools and the loader
+    m_rows_node = m_graph.addNode("rows");
+    m_axis_node = m_graph.addNode("axis");
+    m_order_node = m_graph.addNode("order");
+    m_exclusion_node = m_graph.addNode("exclusions");
+    
+    m_axis_buffer_node = m_graph.addNode("axis buffer", [this]() {
+        m_attribute_ssbo->write(m_axis.data(), Utils::vectorsizeof(m_axis));
+        m_attribute_ssbo->bind_range(GL_SHADER_STORAGE_BUFFER, 3);
+    });
+    m_graph.addDependency(m_axis_buffer_node, m_axis_node);
+    
+    m_indices_node = m_graph.addNode("indices", [this]() { updateVertexIndicies(); });
+    m_graph.addDependency(m_indices_node, m_rows_node);
+    m_graph.addDependency(m_indices_node, m_order_node);
+    m_graph.addDependency(m_indices_node, m_exclusion_node);
+    
+    m_selection_node = m_graph.addNode("selection", [this]() { updateSelectionIndicies(); });
+    m_graph.addDependency(m_selection_node, m_indices_node);
+    
+    m_visible_node = m_graph.addNode("visible segments", [this]() { updateVisibleSegments(); });
+    m_graph.addDependency(m_visible_node, m_axis_node);
+    m_graph.addDependency(m_visible_node, m_indices_node);
+    
+    m_hover_node = m_graph.addNode("hover", [this]() { updateHoverIndicies(); });
+    m_graph.addDependency(m_hover_node, m_indices_node);
+    
+    m_layer_node = m_graph.addNode("base layer", [this]() { invalidateBaseLayer(); });
+    m_graph.addDependency(m_layer_node, m_axis_buffer_node);
+    m_graph.addDependency(m_layer_node, m_visible_node);
+    
+    // axis drag must not allocate
+    m_moved_axis.reserve(m_axis.size());
 }
 
-void GraphApp::drawPolyLines() const {
+void GraphApp::reserveSelection(const size_t& count) const {
+    // doubling, a growing brush reallocates only a few times
+    GraphApp* ptr = const_cast<GraphApp*>(this);
+    size_t bytes = std::max<size_t>(count * sizeof(GLuint), SELECTION_MIN_BYTES);
+    if (m_selection_ibo && size_t(m_selection_ibo->capacity()) >= bytes) {
+        return;
+    }
+    size_t capacity = m_selection_ibo ? size_t(m_selection_ibo->capacity()) : 0;
+    while (capacity < bytes) {
+        capacity = std::max<size_t>(capacity * 2, SELECTION_MIN_BYTES);
+    }
+    ptr->m_selection_ibo = std::make_unique<gl::StreamBuffer>("GraphApp", capacity);
+}
+
+void GraphApp::bindPolyLines(const GLuint& ibo, const bool& highlight) const {
     glUseProgram(m_polyline_program);
         
     gl::set_program_uniform(m_polyline_program, glGetUniformLocation(m_polyline_program, "transform"), m_model);
     gl::set_program_uniform(m_polyline_program, glGetUniformLocation(m_polyline_program, "to_range"), glm::vec2(-1, 1));
+    gl::set_program_uniform(m_polyline_program, glGetUniformLocation(m_polyline_program, "highlight_color"), m_highlight_color);
     glProgramUniform1i(m_polyline_program, glGetUniformLocation(m_polyline_program, "num_attributes"), m_axis.size());
+    glProgramUniform1i(m_polyline_program, glGetUniformLocation(m_polyline_program, "highlight"), highlight);
+    setDataFormatUniforms(m_polyline_program);
         
     // bind buffers eventhough they were never unbinded, just to be sure
-    glBindVertexArray(m_vao);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo); 
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_data_ssbo);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_color_ssbo);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_range_ssbo);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_attribute_ssbo);
+    glBindVertexArray(m_vao.id());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo); 
+    bindData();
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_color_ssbo.id());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_range_ssbo.id());
+    m_attribute_ssbo->bind_range(GL_SHADER_STORAGE_BUFFER, 3);
         
     // tell tesellation shader how many verts per line
     glPatchParameteri(GL_PATCH_VERTICES, 2);
-                
+}
+
+void GraphApp::drawPolyLines(const DrawRange& range, const GLint& baseVertex) const {
+    if (range.count == 0) {
+        return;
+    }
+
     // uses buffer currently bound to GL_ELEMENT_ARRAY_BUFFER
-    glDrawElements(GL_PATCHES, m_indicies.size(), GL_UNSIGNED_SHORT, (const void*) 0);
+    glDrawElementsBaseVertex(GL_PATCHES, range.count, GL_UNSIGNED_INT, (const void*)(range.first * sizeof(GLuint)), baseVertex);
 }
     
+void GraphApp::drawPaged(const size_t& base, const std::vector<int>* ids, const size_t& lines, const DrawRange& range) const {
+    /**
+     * Lines of every segment are stored in row order (ids sorted), so the lines 
+     * of one block form a run per segment. A run is drawn right after its block 
+     * became resident, the block of the following run is read ahead meanwhile. 
+     * Selections index their lines directly, all lines use the indices of the 
+     * first block moved to the current one by the base vertex.
+    **/
+
+    GraphApp* ptr = const_cast<GraphApp*>(this);
+    size_t block_rows = m_block_pool.blockRows();
+    size_t end = range.first + range.count;
+    for (size_t line = range.first; line < end; ) {
+        size_t block = (ids ? (*ids)[line] : line) / block_rows;
+        size_t next = ids 
+            ? std::lower_bound(ids->begin() + line, ids->begin() + end, int((block + 1) * block_rows)) - ids->begin()
+            : std::min(end, (block + 1) * block_rows);
+        ptr->m_block_pool.acquire(block);
+        if (next < end) {
+            m_block_pool.prefetch((ids ? (*ids)[next] : next) / block_rows);
+        }
+
+        size_t first = block * block_rows;
+        for (size_t s = m_visible_segments.first; s < m_visible_segments.first + m_visible_segments.count; s++) {
+            if (ids) {
+                drawPolyLines(DrawRange{base + (s * lines + line) * 2, (next - line) * 2});
+            }
+            else {
+                drawPolyLines(DrawRange{(s * block_rows + line - first) * 2, (next - line) * 2}, GLint(first * m_axis.size()));
+            }
+        }
+        line = next;
+    }
+}
+
 void GraphApp::mouseEventListener() const {
     GraphApp* ptr =  const_cast<GraphApp*> (this);
     MouseStatus current = MouseStatus {
@@ -268,7 +916,7 @@ void GraphApp::mouseEventListener() const {
     // this section only gathers mouse event information, no logic here
     {   
         // left-mouse since last click duration
-        auto duration = Utils::ellapsedTime(current.time[Left], std::chrono::system_clock::now());
+        auto duration = Utils::ellapsedTime(current.time[Left], m_input_time);
         
         // left-mouse down - START
         if (!m_prevMouseState.buttons[Left] && current.buttons[Left]) {
@@ -281,7 +929,7 @@ void GraphApp::mouseEventListener() const {
             }
 
             // start reporting ellapsed time
-            current.time[Left] = std::chrono::system_clock::now();
+            current.time[Left] = m_input_time;
             // start reporting moved mouse distance
             current.distance = 0.0f;
         }
@@ -299,6 +947,17 @@ void GraphApp::mouseEventListener() const {
         }
     }  
     
+    // right-mouse brushes ranges on axis, independent of left-mouse state
+    if (!m_prevMouseState.buttons[Right] && current.buttons[Right]) {
+        m_axisBrush_tool->startBrush(current.pos);
+    }
+    else if (m_prevMouseState.buttons[Right] && current.buttons[Right]) {
+        m_axisBrush_tool->updateBrush(current.pos);
+    }
+    else if (m_prevMouseState.buttons[Right] && !current.buttons[Right]) {
+        m_axisBrush_tool->stopBrush(current.pos);
+    }
+    
     // do something with mouse info 
     switch (current.state) {
         case Click: 
@@ -324,8 +983,13 @@ void GraphApp::mouseEventListener() const {
             m_timeSeries_tool->checkSelection(current.pos);
             break;
         default:
-            // check if mouse over axis
-            m_axisDrag_tool->checkSelection();
+            // check if mouse over axis, otherwise over a line
+            if (m_axisDrag_tool->checkSelection()) {
+                updateHover(-1);
+            }
+            else {
+                updateHover(m_hover_tool->checkSelection());
+            }
             break;
     }
     ptr->m_prevMouseState = current;
@@ -333,21 +997,150 @@ void GraphApp::mouseEventListener() const {
 
 void GraphApp::updateAxis(const std::vector<float>& axis) const {
     GraphApp* ptr = const_cast<GraphApp*>(this);
+    if (m_axis == axis) {
+        return;
+    }
+
+    // remember which axis moved, dependents only look at those
+    for (int i = 0; i < axis.size(); i++) {
+        if (m_axis[i] != axis[i] && std::find(m_moved_axis.begin(), m_moved_axis.end(), i) == m_moved_axis.end()) {
+            ptr->m_moved_axis.push_back(i);
+        }
+    }
+
     ptr->m_axis = axis;
-    glNamedBufferSubData(m_attribute_ssbo, 0, Utils::vectorsizeof(m_axis), m_axis.data());
+    ptr->m_graph.markDirty(m_axis_node);
 }
 
 void GraphApp::updateColor(const std::vector<int>& ids, bool reset) const {
-    if(reset){
-        glNamedBufferSubData(m_color_ssbo, 0, Utils::vectorsizeof(m_colors), m_colors.data());
+    /**
+     * Base colors are never touched here, selected lines are drawn
+     * as highlight on top of the cached base layer instead.
+    **/
+    
+    GraphApp* ptr = const_cast<GraphApp*>(this);
+    ptr->m_selection_ids.clear();
+    if (!reset) {
+        // selection may report the same line once per segment
+        ptr->m_selection_ids = ids;
+        std::sort(ptr->m_selection_ids.begin(), ptr->m_selection_ids.end());
+        ptr->m_selection_ids.erase(std::unique(ptr->m_selection_ids.begin(), ptr->m_selection_ids.end()), ptr->m_selection_ids.end());
+    }
+
+    ptr->m_graph.markDirty(m_selection_node);
+}
+
+void GraphApp::updateSelectionIndicies() const {
+    GraphApp* ptr = const_cast<GraphApp*>(this);
+    ptr->m_selection_count = 0;
+    
+    // filtered base layer consists of the selected lines only
+    if (m_filter) {
+        invalidateBaseLayer();
+    }
+    if (m_selection_ids.empty()) {
+        return;
+    }
+    
+    // paged drawing walks selected lines block by block
+    if (m_paged) {
+        std::sort(ptr->m_selection_ids.begin(), ptr->m_selection_ids.end());
+    }
+    
+    /**
+     * Stream compaction of the index buffer: same segment major layout as the 
+     * base lines restricted to the selected lines. Output position of every 
+     * (segment, chunk of lines) is known up front, so chunks are written 
+     * independently straight into mapped gpu memory.
+    **/
+    
+    size_t selected = m_selection_ids.size();
+    size_t chunks = (selected + SELECTION_CHUNK - 1) / SELECTION_CHUNK;
+    reserveSelection(m_segments.size() * selected * 2);
+    auto dst = m_selection_ibo->map_next<GLuint>();
+    auto compact = [this, dst, selected, chunks](size_t item) {
+        size_t segment = item / chunks;
+        size_t begin = (item % chunks) * SELECTION_CHUNK;
+        size_t end = std::min(begin + SELECTION_CHUNK, selected);
+        GLuint* out = dst + (segment * selected + begin) * 2;
+        for (size_t i = begin; i < end; i++) {
+            *out++ = m_selection_ids[i] * m_axis.size() + m_segments[segment].first;
+            *out++ = m_selection_ids[i] * m_axis.size() + m_segments[segment].second;
+        }
+    };
+
+    // small selections stay on this thread, brushing them mustn't wake workers every frame
+    size_t items = m_segments.size() * chunks;
+    if (m_segments.size() * selected >= SELECTION_CHUNK) {
+        Utils::parallelFor(items, compact);
+    }
+    else {
+        for (size_t item = 0; item < items; item++) {
+            compact(item);
+        }
+    }
+    ptr->m_selection_count = m_segments.size() * selected * 2;
+    gl::CallCounter::add_uploaded(m_selection_count * sizeof(GLuint));
+}
+
+void GraphApp::updateHover(const int& picked) const {
+    // hidden lines can't be hovered
+    int id = picked;
+    if (filtered() && !std::binary_search(m_selection_ids.begin(), m_selection_ids.end(), id)) {
+        id = -1;
+    }
+    if (id == m_hover_id) {
+        return;
+    }
+    
+    GraphApp* ptr = const_cast<GraphApp*>(this);
+    ptr->m_hover_id = id;
+    ptr->m_graph.markDirty(m_hover_node);
+    if (id < 0) {
         return;
     }
     
-    std::vector<glm::vec4> tmp_colors = m_colors;
-    for (const auto& i : ids) {
-        tmp_colors[i] = glm::vec4(1,0,0,1);
+    // values of first time step, formatted into a fixed buffer so hovering doesn't allocate
+    if (!spdlog::default_logger_raw()->should_log(spdlog::level::debug)) {
+        return;
+    }
+    char values[HOVER_REPORT_CHARS];
+    size_t length = 0;
+    for (int i = 0; i < m_axis.size() && length < sizeof(values); i++) {
+        length += fmt::format_to_n(values + length, sizeof(values) - length, "{}{}", i > 0 ? ", " : "", m_columns.value(i, id)).size;
     }
-    glNamedBufferSubData(m_color_ssbo, 0, Utils::vectorsizeof(tmp_colors), tmp_colors.data());
+    spdlog::debug("Row {}: {}", id, fmt::string_view(values, std::min(length, sizeof(values))));
+}
+
+void GraphApp::updateHoverIndicies() const {
+    if (m_hover_id < 0) {
+        return;
+    }
+    
+    // pick the hovered line out of every segment
+    auto dst = m_hover_ibo->map_next<GLuint>();
+    for (size_t segment = 0; segment < m_segments.size(); segment++) {
+        dst[segment * 2] = m_hover_id * m_axis.size() + m_segments[segment].first;
+        dst[segment * 2 + 1] = m_hover_id * m_axis.size() + m_segments[segment].second;
+    }
+    gl::CallCounter::add_uploaded(m_segments.size() * 2 * sizeof(GLuint));
+}
+
+void GraphApp::updateVisibleSegments() const {
+    // segments run left to right, so the ones touching the window are a contiguous range
+    GraphApp* ptr = const_cast<GraphApp*>(this);
+    float bound = 1.0f / m_model[0][0];
+    size_t first = m_segments.size();
+    size_t last = 0;
+    for (size_t i = 0; i < m_segments.size(); i++) {
+        float left = m_axis[m_segments[i].first];
+        float right = m_axis[m_segments[i].second];
+        if (glm::max(left, right) >= -bound && glm::min(left, right) <= bound) {
+            first = std::min(first, i);
+            last = i + 1;
+        }
+    }
+    ptr->m_visible_segments = first < last ? DrawRange{first, last - first} : DrawRange{0, 0};
 }
 
 void GraphApp::updateVertexIndicies() const {
@@ -360,51 +1153,74 @@ void GraphApp::updateVertexIndicies() const {
     
     GraphApp* ptr = const_cast<GraphApp*>(this);
     ptr->m_indicies.clear();
+    ptr->m_segments.clear();
     
     // count number of an excluded axis occurence
     // 0 - enter index twice
     // 1 - enter index once
     // 2 - skip index completly
-    std::vector<int> occurences;
+    auto& occurences = ptr->m_axis_occurences;
+    occurences.resize(m_axis.size());
     for (int i = 0; i < m_axis.size(); i++) {
-        occurences.push_back(std::count(m_excludedAxis.begin(), m_excludedAxis.end(), i));
+        occurences[i] = std::count(m_excludedAxis.begin(), m_excludedAxis.end(), i);
     }
 
-    // create new index ordering
-    for (int i = 0; i < m_data.size() / m_num_timeAxis; i += m_axis.size()) {
-        for(int j = 0; j < m_axis.size(); j++){
-            // if axis is excluded twice, skip it
-            if (occurences[m_axisOrder[j]] > 1)
-                continue;
+    // every line has the same layout -> pair up the axis sequence of one line into segments
+    int pending = -1;
+    auto push = [&](const int& attribute) {
+        if (pending < 0) {
+            pending = attribute;
+            return;
+        }
+        ptr->m_segments.push_back({pending, attribute});
+        pending = -1;
+    };
+
+    for(int j = 0; j < m_axis.size(); j++){
+        // if axis is excluded twice, skip it
+        if (occurences[m_axisOrder[j]] > 1)
+            continue;
 
-            // if axis is excluded once and is start or endpoint of line, skip it
-            if (occurences[m_axisOrder[j]] > 0 && (j == 0 || j == m_axis.size() - 1))
-                continue;
-            
-            // add all but first and last indecies
-            if (j != 0 && j != m_axis.size() - 1 && occurences[m_axisOrder[j]] <= 0) {
-                ptr->m_indicies.push_back(i + m_axisOrder[j]);
-            }
-            
-            // all all indicies
-            ptr->m_indicies.push_back(i + m_axisOrder[j]);
+        // if axis is excluded once and is start or endpoint of line, skip it
+        if (occurences[m_axisOrder[j]] > 0 && (j == 0 || j == m_axis.size() - 1))
+            continue;
+        
+        // add all but first and last indecies
+        if (j != 0 && j != m_axis.size() - 1 && occurences[m_axisOrder[j]] <= 0) {
+            push(m_axisOrder[j]);
         }
+        
+        // all all indicies
+        push(m_axisOrder[j]);
     }
 
+    // create new index ordering, segment by segment so visible segments are one range
+    // lines of the preview sample come first in every segment
+    size_t lines = indexLines();
+    bool ordered = m_line_order.size() == lines;
+    ptr->m_indicies.resize(m_segments.size() * lines * 2);
+    for (size_t segment = 0; segment < m_segments.size(); segment++) {
+        size_t first = segment * lines * 2;
+        for (size_t position = 0; position < lines; position++) {
+            size_t line = ordered ? m_line_order[position] : position;
+            ptr->m_indicies[first + position * 2] = line * m_axis.size() + m_segments[segment].first;
+            ptr->m_indicies[first + position * 2 + 1] = line * m_axis.size() + m_segments[segment].second;
+        }
+    }
     
     if (m_indicies.empty()) {
         ptr->m_indicies.push_back(0);
         ptr->m_indicies.push_back(0);
     }
    
-    glNamedBufferSubData(m_ibo, 0, Utils::vectorsizeof(m_indicies), m_indicies.data());
+    glNamedBufferSubData(m_ibo.id(), 0, Utils::vectorsizeof(m_indicies), m_indicies.data());
 }
 
 void GraphApp::updateOrder(const std::vector<int>& order) const {
     GraphApp* ptr = const_cast<GraphApp*>(this);
     if (m_axisOrder != order) {
         ptr->m_axisOrder = order;
-        updateVertexIndicies();
+        ptr->m_graph.markDirty(m_order_node);
     }
 }
 
@@ -412,19 +1228,15 @@ void GraphApp::updateExcludedAxis(const std::vector<int>& axis) const {
     GraphApp* ptr = const_cast<GraphApp*>(this);
     if (m_excludedAxis != axis) {
         ptr->m_excludedAxis = axis;
-        updateVertexIndicies();
+        ptr->m_graph.markDirty(m_exclusion_node);
     }
 }
 
-const std::vector<Vertex>* GraphApp::getVertecies(){
-    return &m_vertices;
-}
-
 const std::vector<float>* GraphApp::getAxis() {
     return &m_axis;
 }
 
-const std::vector<unsigned short>* GraphApp::getIndicies() {
+const std::vector<GLuint>* GraphApp::getIndicies() {
     return &m_indicies;
 }
 
@@ -432,6 +1244,10 @@ const std::vector<float>* GraphApp::getData() {
     return &m_data;
 }
 
+const ColumnStore* GraphApp::getColumns() {
+    return &m_columns;
+}
+
 const std::vector<glm::vec4>* GraphApp::getColor() {
     return &m_colors;
 }
@@ -452,20 +1268,282 @@ const int* GraphApp::getNumTimeAxis() {
     return &m_num_timeAxis;
 }
 
+void GraphApp::setDataFormatUniforms(const GLuint& program) const {
+    glProgramUniform1i(program, glGetUniformLocation(program, "quantized"), m_quantized);
+    glProgramUniform1i(program, glGetUniformLocation(program, "row_words"), m_row_words);
+    glProgramUniform1i(program, glGetUniformLocation(program, "paged"), m_paged);
+    glProgramUniform1i(program, glGetUniformLocation(program, "block_rows"), m_block_pool.blockRows());
+}
+
+gl::BufferPool* GraphApp::getIndexPool() {
+    return &m_index_pool;
+}
+
+gl::BufferPool* GraphApp::getVertexPool() {
+    return &m_vertex_pool;
+}
+
+DependencyGraph* GraphApp::getGraph() {
+    return &m_graph;
+}
+
+DependencyGraph::Node GraphApp::getAxisNode() const {
+    return m_axis_node;
+}
+
+DependencyGraph::Node GraphApp::getExclusionNode() const {
+    return m_exclusion_node;
+}
+
+const std::vector<std::pair<int, int>>* GraphApp::getSegments() {
+    return &m_segments;
+}
+
+const DrawRange& GraphApp::getVisibleSegments() const {
+    return m_visible_segments;
+}
+
+DependencyGraph::Node GraphApp::getRowsNode() const {
+    return m_rows_node;
+}
+
+bool GraphApp::loading() const {
+    return !m_loader->done();
+}
+
+bool GraphApp::input_ready() const {
+    // replayed frames only line up once all rows are there
+    return !loading();
+}
+
+bool GraphApp::idle() const {
+    return !loading() && !m_layer_dirty && m_progressive.done();
+}
+
+const AxisIndex* GraphApp::getAxisIndex() {
+    return &m_axis_index;
+}
+
+DependencyGraph::Node GraphApp::getVisibleNode() const {
+    return m_visible_node;
+}
+
+const std::vector<int>* GraphApp::getMovedAxis() {
+    return &m_moved_axis;
+}
+
+gl::ProgramLibrary* GraphApp::getProgramLibrary() {
+    return &m_programLibrary;
+}
+
 const GraphApp* GraphApp::getPtr() {
     return this;
 }
 
-const GLuint* GraphApp::getVAO() {
-    return &m_vao;
+size_t GraphApp::getFrameAllocations() const {
+    return m_frame_allocations;
+}
+
+GLuint GraphApp::getVAO() {
+    return m_vao.id();
 }
 
-const GLuint* GraphApp::getAttribute_SSBO() {
-    return &m_attribute_ssbo;
+const gl::StreamBuffer* GraphApp::getAttribute_SSBO() {
+    return m_attribute_ssbo.get();
 }
 
-int main() {
-    GraphApp app; 
+int GraphApp::benchmark(Settings settings) {
+    /**
+     * Core routines on a standard synthetic dataset, medians are compared
+     * against the baseline file. Without a baseline (or with one of another 
+     * dataset) there is nothing to compare, the run reports SKIPPED and 
+     * --update-baseline stores the results as new one.
+    **/
+
+    const size_t rows = 100000;
+    const int attributes = 8;
+    Benchmark benchmark(settings.benchmarkPath, fmt::format("synthetic-{}x{}x{}", rows, attributes, settings.timeSteps));
+    if (!settings.updateBaseline && !benchmark.hasBaseline()) {
+        spdlog::warn("No baseline in '{}', run --update-baseline", settings.benchmarkPath);
+        return SKIPPED;
+    }
+    settings.dataPath = (std::filesystem::temp_directory_path() / "gl-playground-benchmark.csv").string();
+    settings.headless = true;
+    Benchmark::writeSyntheticCsv(settings.dataPath, rows, attributes);
+
+    // split and convert every line, what the loader thread does
+    auto dataset = Dataset::open(settings.dataPath);
+    std::vector<float> values;
+    values.reserve(rows * attributes);
+    benchmark.measure("csv_parse", [&dataset, &values]() {
+        std::ifstream file(dataset.path);
+        std::string line;
+        values.clear();
+        if (dataset.header) {
+            std::getline(file, line);
+        }
+        while (std::getline(file, line)) {
+            dataset.parseLine(line, dataset.columns, values);
+        }
+    }, 5);
+
+    {
+        GraphApp app(settings);
+        while (app.loading()) {
+            app.update();
+            app.draw();
+        }
+        app.runBenchmarks(benchmark);
+    }
+
+    if (settings.updateBaseline) {
+        benchmark.store();
+        return 0;
+    }
+    return benchmark.compare() ? 0 : 1;
+}
+
+void GraphApp::runBenchmarks(Benchmark& benchmark) {
+    int lines = m_colors.size();
+    benchmark.measure("ranges", [this]() { m_ranges = initializeRanges(); });
+    benchmark.measure("vertex_indices", [this]() { updateVertexIndicies(); });
+    
+    // expansion across all axis, every middle segment is written
+    benchmark.measure("expansion_update", [this, lines]() {
+        ExpansionMiddle middle(m_axisOrder.front(), m_axisOrder.back(), lines, m_axis.size(), m_polyline_program, this);
+        middle.updateAxis(std::vector<int>(m_axisOrder.begin() + 1, m_axisOrder.end() - 1));
+    });
+
+    // box over the middle fifth of the window
+    auto center = glm::vec2(m_resolution) * 0.5f;
+    auto extent = glm::vec2(m_resolution) * 0.1f;
+    m_boxSelect_tool->setSelectionOrigin_callback(center - extent);
+    m_boxSelect_tool->updateSelection_callback(center + extent);
+    benchmark.measure("box_intersection", [this]() { m_boxSelect_tool->checkIntersection(); });
+    m_boxSelect_tool->stopSelection_callback();
+    m_boxSelect_tool->clearSelection();
+    m_graph.update();
+    
+    // every line selected, the compaction writes as many indices as the base layer
+    m_selection_ids.resize(lines);
+    std::iota(m_selection_ids.begin(), m_selection_ids.end(), 0);
+    benchmark.measure("selection_indices", [this]() { updateSelectionIndicies(); });
+    m_selection_ids.clear();
+    m_graph.markDirty(m_selection_node);
+    m_graph.update();
+
+    // whole base layer until accumulation is done, and a frame with nothing to redraw
+    benchmark.measure("frame_full", [this]() {
+        invalidateBaseLayer();
+        do {
+            draw();
+        } while (!m_progressive.done());
+        glFinish();
+    }, 5);
+    benchmark.measure("frame_steady", [this]() {
+        draw();
+        glFinish();
+    });
+}
+
+bool GraphApp::allocationTest(Settings settings) {
+    /**
+     * Drives a box selection, an axis brush, hovering over lines and an axis 
+     * drag through the input path, one frame per cursor move. Each sweeps 
+     * back and forth over the same path: 
+     * the first sweep may grow scratch buffers, frames of the later ones 
+     * must not allocate at all.
+    **/
+
+    const int steps = 32;
+    settings.dataPath = (std::filesystem::temp_directory_path() / "gl-playground-allocations.csv").string();
+    settings.headless = true;
+    Benchmark::writeSyntheticCsv(settings.dataPath, 100000, 8);
+    
+    GraphApp app(settings);
+    while (app.loading()) {
+        app.update();
+        app.draw();
+    }
+    Scheduler::instance().wait(app.m_stats_task);
+    
+    // cursor positions relative to the window, x between two axis or on one
+    auto screen = [&app](const float& x) { return (x * app.getModel()[0][0] + 1.0f) * 0.5f; };
+    const auto& order = app.m_axisOrder;
+    float second = app.m_axis[order[1]];
+    float first_gap = (app.m_axis[order[0]] + second) * 0.5f;
+    float last_gap = (app.m_axis[order[order.size() - 2]] + app.m_axis[order.back()]) * 0.5f;
+    
+    auto frame = [&app](const InputType& type, const int& button, const int& action, const glm::vec2& pos) {
+        app.handle_input(InputEvent{0, 0.0f, type, uint8_t(action), 0, uint8_t(button), 0, 0, pos.x, pos.y});
+        app.draw();
+        gl::CallCounter::instance().end_frame();
+        return app.getFrameAllocations();
+    };
+    // negative button -> cursor moves without a press
+    auto sweep = [&frame](const char* name, const int& button, const glm::vec2& from, const glm::vec2& to) {
+        frame(InputType::MOVE, 0, 0, from);
+        if (button >= 0) {
+            frame(InputType::BUTTON, button, GLFW_PRESS, from);
+        }
+        size_t worst = 0;
+        for (int pass = 0; pass < 3; pass++) {
+            for (int i = 1; i <= steps; i++) {
+                float t = float(i) / steps;
+                auto allocations = frame(InputType::MOVE, 0, 0, pass % 2 == 0 ? glm::mix(from, to, t) : glm::mix(to, from, t));
+                if (pass > 0) {
+                    worst = std::max(worst, allocations);
+                }
+            }
+        }
+        if (button >= 0) {
+            frame(InputType::BUTTON, button, GLFW_RELEASE, to);
+        }
+        
+        if (worst > 0) {
+            spdlog::error("{}: {} heap allocations in a warm frame", name, worst);
+        }
+        else {
+            spdlog::info("{}: no heap allocations in warm frames", name);
+        }
+        return worst == 0;
+    };
+    
+    bool passed = sweep("box select", GLFW_MOUSE_BUTTON_LEFT, 
+        glm::vec2(screen(first_gap), 0.2f), glm::vec2(screen(last_gap), 0.8f));
+    passed &= sweep("axis brush", GLFW_MOUSE_BUTTON_RIGHT, glm::vec2(screen(second), 0.3f), glm::vec2(screen(second), 0.7f));
+    passed &= sweep("hover", -1, glm::vec2(screen(first_gap), 0.1f), glm::vec2(screen(first_gap), 0.9f));
+    
+    // the axis stays between its neighbours, a press right after the box selection would be a double click
+    float second_gap = (second + app.m_axis[order[2]]) * 0.5f;
+    std::this_thread::sleep_for(std::chrono::milliseconds(int(DOUBLECLICK_TIME_MS)));
+    passed &= sweep("axis drag", GLFW_MOUSE_BUTTON_LEFT, glm::vec2(screen(second), 0.5f), glm::vec2(screen(second_gap), 0.5f));
+    return passed;
+}
+
+int main(int argc, char** argv) {
+    auto settings = Utils::parseSettings(argc, argv);
+    if (!settings.convertPath.empty()) {
+        Dataset::open(settings.dataPath).convert(settings.convertPath);
+        return 0;
+    }
+    if (settings.benchScheduler) {
+        Scheduler::benchmark();
+        return 0;
+    }
+    if (!settings.benchmarkPath.empty()) {
+        return GraphApp::benchmark(settings);
+    }
+    if (settings.allocationTest) {
+        // allocations can't be counted in this build
+        if (!AllocationCounter::enabled()) {
+            spdlog::warn("Allocation test needs a build with COUNT_ALLOCATIONS");
+            return GraphApp::SKIPPED;
+        }
+        return GraphApp::allocationTest(settings) ? 0 : 1;
+    }
+
+    GraphApp app(settings); 
     app.run();
     return 0;
 }
@@ -9,38 +9,83 @@
 #include <boxSelect.hpp>
 #include <axisDrag.hpp>
 #include <timeSeries.hpp>
+#include <hoverPick.hpp>
+#include <axisBrush.hpp>
+#include <progressiveRenderer.hpp>
+#include <allocationCounter.hpp>
+#include <dependencyGraph.hpp>
+#include <pairwiseStats.hpp>
+#include <axisIndex.hpp>
+#include <columnStore.hpp>
+#include <dataLoader.hpp>
+#include <scheduler.hpp>
+#include <rowBlockPool.hpp>
+#include <mappedFile.hpp>
+#include <stratifiedSample.hpp>
+#include <benchmark.hpp>
+#include <gl/stream_buffer.hpp>
+#include <gl/program_library.hpp>
+#include <gl/buffer_pool.hpp>
+#include <gl/resource.hpp>
 
 
 // assure compile class will be there
 class BoxSelect;
 class AxisDrag;
 class TimeSeries;
+class HoverPick;
+class AxisBrush;
 
 class GraphApp : 
     public Application, 
     public std::enable_shared_from_this<GraphApp> 
 {
  public:
-    GraphApp();
+    static const int SKIPPED = 77; // exit code ctest reports as skipped
+
+    GraphApp(const Settings& settings);
     ~GraphApp();
+    static int benchmark(Settings settings); // exit code, 1 -> a routine regressed, SKIPPED -> no baseline
+    static bool allocationTest(Settings settings); // false -> a warm brush frame allocated
 	bool draw() const override;
+    void on_resize(int width, int height) override;
+    void on_scroll(double x, double y) override;
+    void on_key(int key, int scancode, int action, int mods) override;
+    void invalidateBaseLayer() const;
     void updateColor(const std::vector<int>& ids, bool reset = false) const;
     void updateAxis(const std::vector<float>& axis) const;
     void updateVertexIndicies() const;
-    const std::vector<Vertex>* getVertecies();
-    const std::vector<unsigned short>* getIndicies();
+    const std::vector<GLuint>* getIndicies();
     const std::vector<float>* getAxis();
     const std::vector<float>* getData();
+    const ColumnStore* getColumns();
     const std::vector<glm::vec4>* getColor();
     const glm::mat4& getModel();
     const std::vector<glm::vec2>* getRanges();
     const std::vector<int>* getAxisOrder();
     const GraphApp* getPtr();
-    const GLuint* getVAO();
-    const GLuint* getAttribute_SSBO();
+    GLuint getVAO();
+    const gl::StreamBuffer* getAttribute_SSBO();
     const int* getNumTimeAxis();
+    gl::ProgramLibrary* getProgramLibrary();
+    gl::BufferPool* getIndexPool();
+    gl::BufferPool* getVertexPool();
+    void setDataFormatUniforms(const GLuint& program) const;
+    size_t getFrameAllocations() const;
     void updateOrder(const std::vector<int>& order) const;
     void updateExcludedAxis(const std::vector<int>& axis) const;
+    DependencyGraph* getGraph();
+    DependencyGraph::Node getAxisNode() const;
+    DependencyGraph::Node getExclusionNode() const;
+    const std::vector<int>* getMovedAxis();
+    void setAxisViewport(const float& first, const int& visible);
+    const std::vector<std::pair<int, int>>* getSegments();
+    const DrawRange& getVisibleSegments() const;
+    DependencyGraph::Node getVisibleNode() const;
+    DependencyGraph::Node getRowsNode() const;
+    bool loading() const;
+    void updateHover(const int& picked) const;
+    const AxisIndex* getAxisIndex();
 
 private: 
 	std::vector<float> initializeData();
@@ -50,37 +95,124 @@ private:
 	void initializeVertexBuffers();
 	void initializeStorageBuffers();
 	void initializeIndexBuffer();	
+    void initializeLayer();
+    
+    void initializeGraph();
+    void uploadData();
+    void bindData() const;
+    void fillRows(const size_t& first, const size_t& count, float* rows) const;
+    void prefetchRows(const size_t& first, const size_t& count) const;
+    size_t pagedBlockRows() const;
+    size_t indexLines() const; // lines in the index buffer
+    void updateLineOrder();
+    void updateLoading() const;
+    void appendRows(LoadedChunk& chunk);
+    void updateStatistics();
+    void flushStatistics();
+    void swapColumn(const int& attribute, const int& step);
+    void drawProgress() const;
     
-    void drawPolyLines() const;
+    void updateBaseLayer() const;
+    bool filtered() const;
+    size_t baseLines() const;
+    void updateSelectionIndicies() const;
+    void updateVisibleSegments() const;
+    void updateHoverIndicies() const;
+    void bindPolyLines(const GLuint& ibo, const bool& highlight) const;
+    void drawPolyLines(const DrawRange& range, const GLint& baseVertex = 0) const;
+    void drawPaged(const size_t& base, const std::vector<int>* ids, const size_t& lines, const DrawRange& range) const;
+    void reserveSelection(const size_t& count) const;
 	void mouseEventListener() const;
+    void runBenchmarks(Benchmark& benchmark);
 
 protected:
+    bool input_ready() const override;
+    bool idle() const override;
+
+    gl::ProgramLibrary m_programLibrary; // has to outlive tools, they share its programs
+    DependencyGraph m_graph; // derived state, recomputed once per frame when dirty
+    DependencyGraph::Node m_rows_node;
+    DependencyGraph::Node m_axis_node;
+    DependencyGraph::Node m_axis_buffer_node;
+    DependencyGraph::Node m_order_node;
+    DependencyGraph::Node m_exclusion_node;
+    DependencyGraph::Node m_indices_node;
+    DependencyGraph::Node m_selection_node;
+    DependencyGraph::Node m_visible_node;
+    DependencyGraph::Node m_layer_node;
+    DependencyGraph::Node m_hover_node;
+    gl::BufferPool m_index_pool; // shared by all expansions
+    gl::BufferPool m_vertex_pool;
     glm::mat4 m_model;
 	GLuint m_polyline_program;
     GLuint m_axis_program;
-    GLuint m_vao;
-    GLuint m_vbo;
-    GLuint m_ibo;
-    GLuint m_data_ssbo;
-    GLuint m_color_ssbo;
-    GLuint m_attribute_ssbo;
-    GLuint m_range_ssbo;
+    gl::VertexArray m_vao;
+    gl::Buffer m_ibo; // all lines (one block of lines if paged), only rewritten when order, exclusions or rows change
+    gl::Buffer m_data_ssbo;
+    gl::Buffer m_color_ssbo;
+    std::unique_ptr<gl::StreamBuffer> m_attribute_ssbo;
+    gl::Buffer m_range_ssbo;
+    gl::Buffer m_quantization_ssbo;
+    std::unique_ptr<gl::StreamBuffer> m_selection_ibo; // grows with the selection
+    std::unique_ptr<gl::StreamBuffer> m_hover_ibo; // single line under the cursor
+    GLuint m_layer_fbo; // cached base polylines, only redrawn when invalidated
+    GLuint m_layer_texture;
+    gl::Registration m_layer_registration;
+    ProgressiveRenderer m_progressive; // accumulates base layer over multiple frames
+    PairwiseStats m_stats; // attribute correlations & crossings for automatic ordering
+    TaskGroup m_stats_task; // background append of streamed rows to m_stats
+    ColumnStore m_columns; // first time step column major, read by m_stats, m_axis_index & the tools
+    AxisIndex m_axis_index; // per attribute sorted rows for range brushes
+    RowBlockPool m_block_pool;
+    std::unique_ptr<MappedFile> m_mapping; // columnar file, source of paged blocks
+    size_t m_mapped_rows;
+    uint64_t m_mapped_offset;
+    StratifiedSample m_sample; // preview rows, drawn first by the progressive base layer
+    std::vector<int> m_line_order; // line at every position of a segment, empty -> row order
     
+    Dataset m_dataset; // projected columns of the data file, one per attribute
     int m_num_attributes;
     int m_num_timeAxis;
+    bool m_paged; // data ssbo is a pool of resident row blocks read from a mapped columnar file, see RowBlockPool
+    bool m_quantized; // data ssbo holds packed 8/16 bit values instead of floats
+    size_t m_resident_bytes; // gpu budget of the pool, line colors and block indices
+    int m_row_words; // packed 32 bit words per data row
+    QuantizedData m_quantization; // layout of the packed rows, words live on the gpu only
+    int m_visible_axes; // axis slots spread across [-1,1]
+    float m_axis_first; // slot at the left border, fractional while scrolling
+    std::unique_ptr<DataLoader> m_loader; // rows keep arriving after the first frame
     std::vector<float> m_axis;
-    std::vector<float> m_data;
-    std::vector<Vertex> m_vertices;
+    std::vector<float> m_data; // all time steps, first chunk only if paged
     std::vector<glm::vec2> m_ranges;
     std::vector<glm::vec4> m_colors;
     std::vector<Vertex> m_selection;
-    std::vector<unsigned short> m_indicies;
+    std::vector<GLuint> m_indicies; // segment major, all lines of a segment are contiguous
+    std::vector<std::pair<int, int>> m_segments; // attribute pairs of every line, left to right
+    DrawRange m_visible_segments; // only segments touching the window get drawn
+    size_t m_selection_count;
+    std::vector<int> m_selection_ids;
     std::vector<int> m_axisOrder;
     std::vector<int> m_excludedAxis;
+    std::vector<int> m_axis_occurences; // scratch for updateVertexIndicies
+    std::vector<int> m_moved_axis; // axis moved since last graph update
     
     bool m_selecting;
-    BoxSelect* m_boxSelect_tool;
-    AxisDrag* m_axisDrag_tool;
-    TimeSeries* m_timeSeries_tool;
+    bool m_layer_dirty;
+    bool m_filter; // base layer only draws selected lines
+    bool m_check_allocations;
+    size_t m_frame_allocations; // heap allocations during last frame
+    glm::vec4 m_highlight_color;
+    glm::vec4 m_hover_color;
+    int m_hover_id; // line under the cursor, -1 if none
+    std::unique_ptr<BoxSelect> m_boxSelect_tool;
+    std::unique_ptr<AxisDrag> m_axisDrag_tool;
+    std::unique_ptr<TimeSeries> m_timeSeries_tool;
+    std::unique_ptr<HoverPick> m_hover_tool;
+    std::unique_ptr<AxisBrush> m_axisBrush_tool;
     MouseStatus m_prevMouseState;
+    
+    static const size_t SELECTION_MIN_BYTES = 1 << 20; // initial selection ring region
+    static const size_t HOVER_REPORT_CHARS = 256; // values of a hovered row in the debug log
+    static const size_t BLOCK_BYTES = 1 << 22; // size of a paged row block
+    static constexpr size_t SELECTION_CHUNK = 1 << 16; // lines per compaction work item
 };
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include <hoverPick.hpp>
+
+HoverPick::HoverPick(GraphApp* app) :
+    Tool{app},
+    m_tolerance_px{4.0f},
+    m_dirty{true}
+{
+    // model relative to screen space
+    m_mouse_model = glm::scale(glm::mat4{1.0f}, glm::vec3{
+        1.0f / m_linkedApp->getModel()[0][0], 
+        1.0f / m_linkedApp->getModel()[1][1], 
+        1.0f / m_linkedApp->getModel()[2][2]}
+    );
+}
+
+bool HoverPick::draw() const {
+    // hovered line is drawn by GraphApp along with the selection
+    return true;
+}
+
+bool HoverPick::registerTool() {
+    // grid follows the visible segments, rebuild waits for the next hover query
+    auto graph = m_linkedApp->getGraph();
+    auto node = graph->addNode("hover grid", [this]() { m_dirty = true; });
+    graph->addDependency(node, m_linkedApp->getVisibleNode());
+    return true;
+}
+
+int HoverPick::checkSelection() const {
+    if (m_dirty) {
+        rebuild();
+    }
+
+    auto pos = m_linkedApp->mouse_pos();
+    auto resolution = m_linkedApp->resolution();
+    float x = Utils::remap(pos.x, glm::vec2(0, resolution.x), glm::vec2(-1,1));
+    float y = Utils::remap(pos.y, glm::vec2(0, resolution.y), glm::vec2(-1,1));
+    auto ss_pos = m_mouse_model * glm::vec4(glm::vec2(x,y), 0, 1);
+    
+    // pixel tolerance in polyline space, the larger of both axis
+    float tolerance = glm::max(
+        2 * m_tolerance_px / resolution.x * m_mouse_model[0][0], 
+        2 * m_tolerance_px / resolution.y * m_mouse_model[1][1]
+    );
+    return m_grid.nearest(glm::vec2(ss_pos.x, ss_pos.y), tolerance);
+}
+
+void HoverPick::rebuild() const {
+    /**
+     * Flattens the bezier curve of every visible segment of every line into 
+     * straight pieces, same curve as the tesselation shader. Lines are 
+     * independent so pieces are written in parallel.
+    **/
+    
+    HoverPick* ptr = const_cast<HoverPick*>(this);
+    const auto& segments = *m_linkedApp->getSegments();
+    const auto& visible = m_linkedApp->getVisibleSegments();
+    const auto& axis = *m_linkedApp->getAxis();
+    const auto& columns = *m_linkedApp->getColumns();
+    const auto& ranges = *m_linkedApp->getRanges();
+    size_t lines = m_linkedApp->getColor()->size();
+    
+    auto& pieces = ptr->m_grid.segments();
+    pieces.resize(visible.count * lines * PIECES);
+    Utils::parallelFor(visible.count, [&](size_t i) {
+        auto [left, right] = segments[visible.first + i];
+        for (size_t line = 0; line < lines; line++) {
+            glm::vec2 p0 = glm::vec2(axis[left], Utils::remap(columns.value(left, line), ranges[left], glm::vec2(-1,1)));
+            glm::vec2 p3 = glm::vec2(axis[right], Utils::remap(columns.value(right, line), ranges[right], glm::vec2(-1,1)));
+            float intermediate_x = p0.x + 0.5f * (p3.x - p0.x);
+            glm::vec2 p1 = glm::vec2(intermediate_x, p0.y);
+            glm::vec2 p2 = glm::vec2(intermediate_x, p3.y);
+            
+            glm::vec2 prev = p0;
+            size_t first = (i * lines + line) * PIECES;
+            for (int k = 1; k <= PIECES; k++) {
+                glm::vec2 next = Utils::bezier(float(k) / PIECES, p0, p1, p2, p3);
+                pieces[first + k - 1] = GridSegment{prev, next, int(line)};
+                prev = next;
+            }
+        }
+    });
+
+    // cells about as large as the pick tolerance
+    auto resolution = m_linkedApp->resolution();
+    ptr->m_grid.build(2 * m_tolerance_px / resolution.x * m_mouse_model[0][0]);
+    ptr->m_dirty = false;
+    
+    spdlog::debug("Hover grid rebuilt with {} pieces in {} cells", pieces.size(), m_grid.cells());
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <spdlog/spdlog.h>
+
+#include <tool.hpp>
+#include <structs.hpp>
+#include <utils.hpp>
+#include <graphApp.hpp>
+#include <segmentGrid.hpp>
+
+class HoverPick : Tool {
+public:
+    HoverPick(GraphApp* app);
+    bool draw() const override;
+    bool registerTool() override;
+    int checkSelection() const;
+
+private:
+    void rebuild() const;
+    
+    static const int PIECES = 8; // straight pieces per bezier segment
+    
+    glm::mat4 m_mouse_model; // scale of screen to polyine
+    float m_tolerance_px;
+    SegmentGrid m_grid; // flattened visible segments, rebuilt lazily after layout changes
+    bool m_dirty;
+};
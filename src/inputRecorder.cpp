@@ -0,0 +1,174 @@
+#include <inputRecorder.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    const char MAGIC[8] = {'G', 'L', 'P', 'I', 'N', 'P', 'T', '1'};
+    const size_t RECORD_BYTES = 24;
+
+    template<typename T>
+    char* put(char* dst, const T& value) {
+        std::memcpy(dst, &value, sizeof(T));
+        return dst + sizeof(T);
+    }
+
+    template<typename T>
+    const char* get(const char* src, T& value) {
+        std::memcpy(&value, src, sizeof(T));
+        return src + sizeof(T);
+    }
+}
+
+InputRecorder::InputRecorder(const std::string& path) :
+    m_path{path},
+    m_file{path, std::ios::binary},
+    m_start{std::chrono::steady_clock::now()},
+    m_events{0}
+{
+    if (!m_file) {
+        throw std::runtime_error("Failed to open input recording '" + path + "'");
+    }
+    m_file.write(MAGIC, sizeof(MAGIC));
+}
+
+InputRecorder::~InputRecorder() {
+    spdlog::info("Recorded {} input events to '{}'", m_events, m_path);
+}
+
+void InputRecorder::record(InputEvent event, const uint32_t& frame) {
+    event.frame = frame;
+    event.time = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    
+    // field by field, no padding in the file
+    char record[RECORD_BYTES];
+    char* dst = put(record, event.frame);
+    dst = put(dst, event.time);
+    dst = put(dst, event.type);
+    dst = put(dst, event.action);
+    dst = put(dst, event.mods);
+    dst = put(dst, event.button);
+    dst = put(dst, event.key);
+    dst = put(dst, event.scancode);
+    dst = put(dst, event.x);
+    put(dst, event.y);
+    m_file.write(record, RECORD_BYTES);
+    m_events++;
+}
+
+std::vector<InputEvent> InputRecorder::read(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("'" + path + "' isn't an input recording");
+    }
+    
+    std::vector<InputEvent> events;
+    char record[RECORD_BYTES];
+    while (file.read(record, RECORD_BYTES)) {
+        InputEvent event;
+        const char* src = get(record, event.frame);
+        src = get(src, event.time);
+        src = get(src, event.type);
+        src = get(src, event.action);
+        src = get(src, event.mods);
+        src = get(src, event.button);
+        src = get(src, event.key);
+        src = get(src, event.scancode);
+        src = get(src, event.x);
+        get(src, event.y);
+        events.push_back(event);
+    }
+    return events;
+}
+
+InputReplay::InputReplay(const std::string& path) :
+    m_events{InputRecorder::read(path)},
+    m_next{0}
+{
+    spdlog::info("Replaying {} input events of '{}'", m_events.size(), path);
+}
+
+void InputReplay::startStep(const InputEvent& event) {
+    std::string name = "start";
+    if (event.type == InputType::KEY) {
+        name = "key " + std::to_string(event.key);
+    }
+    else if (event.type == InputType::BUTTON) {
+        name = "button " + std::to_string(event.button);
+    }
+    else if (event.type == InputType::SCROLL) {
+        name = "scroll";
+    }
+    m_steps.push_back(Step{name, 0, 0.0, 0.0, {}, {}});
+}
+
+void InputReplay::dispatch(const uint32_t& frame, const std::function<void(const InputEvent&)>& apply) {
+    if (m_steps.empty()) {
+        m_steps.push_back(Step{"start", 0, 0.0, 0.0, {}, {}});
+    }
+    
+    // presses start steps, scrolling starts one unless the step already is one
+    for (; m_next < m_events.size() && m_events[m_next].frame <= frame; m_next++) {
+        const auto& event = m_events[m_next];
+        bool press = (event.type == InputType::KEY || event.type == InputType::BUTTON) && event.action == 1;
+        bool scroll = event.type == InputType::SCROLL && m_steps.back().name != "scroll";
+        if (press || scroll) {
+            startStep(event);
+        }
+        apply(event);
+    }
+}
+
+void InputReplay::measure(const char* section, const double& ms) {
+    if (m_steps.empty()) {
+        return;
+    }
+    auto& sections = m_steps.back().sections;
+    auto it = sections.find(section);
+    if (it == sections.end()) {
+        it = sections.emplace(section, 0.0).first;
+    }
+    it->second += ms;
+}
+
+void InputReplay::finishFrame(const double& ms, const gl::CallCounts& counts) {
+    if (m_steps.empty()) {
+        return;
+    }
+    auto& step = m_steps.back();
+    step.frames++;
+    step.total += ms;
+    step.max = std::max(step.max, ms);
+    step.calls.draws += counts.draws;
+    step.calls.program_switches += counts.program_switches;
+    step.calls.buffer_binds += counts.buffer_binds;
+    step.calls.uniform_sets += counts.uniform_sets;
+    step.calls.uploaded_bytes += counts.uploaded_bytes;
+    step.calls.primitives += counts.primitives;
+}
+
+bool InputReplay::done() const {
+    return m_next == m_events.size();
+}
+
+void InputReplay::report() const {
+    for (size_t i = 0; i < m_steps.size(); i++) {
+        const auto& step = m_steps[i];
+        if (step.frames == 0) {
+            continue;
+        }
+        spdlog::info("Step {} '{}': {} frames, {:.2f} ms mean, {:.2f} ms max", 
+            i, step.name, step.frames, step.total / step.frames, step.max);
+        for (const auto& section : step.sections) {
+            spdlog::info("    {}: {:.3f} ms per frame", section.first, section.second / step.frames);
+        }
+        
+        // gl calls per frame
+        double frames = double(step.frames);
+        spdlog::info("    {:.1f} draws, {:.1f} program switches, {:.1f} buffer binds, {:.1f} uniform sets, {:.1f} KB uploaded, {:.0f} primitives", 
+            step.calls.draws / frames, step.calls.program_switches / frames, step.calls.buffer_binds / frames, 
+            step.calls.uniform_sets / frames, step.calls.uploaded_bytes / frames / 1024.0, step.calls.primitives / frames);
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include <gl/call_counter.hpp>
+
+enum class InputType : uint8_t {KEY, BUTTON, MOVE, SCROLL};
+
+/**
+ * One glfw input event. Cursor positions are relative to the resolution 
+ * (origin bottom left), so recordings replay on any window size.
+**/
+struct InputEvent {
+    uint32_t frame; // events of one frame are applied together
+    float time; // ms since recording started
+    InputType type;
+    uint8_t action;
+    uint8_t mods;
+    uint8_t button;
+    int16_t key;
+    int16_t scancode;
+    float x; // cursor position or scroll offset
+    float y;
+};
+
+/**
+ * Writes events to a binary file: 8 byte magic followed by one 24 byte 
+ * record per event, little endian.
+**/
+class InputRecorder {
+public:
+    InputRecorder(const std::string& path);
+    ~InputRecorder();
+    void record(InputEvent event, const uint32_t& frame);
+    static std::vector<InputEvent> read(const std::string& path);
+
+private:
+    std::string m_path;
+    std::ofstream m_file;
+    std::chrono::steady_clock::time_point m_start;
+    size_t m_events;
+};
+
+/**
+ * Feeds the events of a recording back on the frames they were recorded 
+ * on. Every key or button press starts a new step, per step the frame 
+ * times and the cpu time of every measured section are reported.
+**/
+class InputReplay {
+public:
+    InputReplay(const std::string& path);
+    void dispatch(const uint32_t& frame, const std::function<void(const InputEvent&)>& apply);
+    void measure(const char* section, const double& ms);
+    void finishFrame(const double& ms, const gl::CallCounts& counts);
+    bool done() const;
+    void report() const;
+
+private:
+    struct Step {
+        std::string name; // input that started the step
+        size_t frames;
+        double total; // ms of all frames
+        double max;
+        std::map<std::string, double, std::less<>> sections; // summed cpu ms
+        gl::CallCounts calls; // summed over all frames
+    };
+    
+    void startStep(const InputEvent& event);
+    
+    std::vector<InputEvent> m_events;
+    size_t m_next;
+    std::vector<Step> m_steps;
+};
@@ -0,0 +1,93 @@
+#include <mappedFile.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& path) :
+    m_data{nullptr},
+    m_size{0},
+    m_file{INVALID_HANDLE_VALUE},
+    m_mapping{nullptr}
+{
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER size;
+    if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size)) {
+        throw std::runtime_error("Failed to open '" + path + "' for mapping!");
+    }
+    m_size = size.QuadPart;
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    m_data = m_mapping ? static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+    if (!m_data) {
+        throw std::runtime_error("Failed to map '" + path + "'!");
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+    }
+    if (m_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file);
+    }
+}
+
+void MappedFile::prefetch(const size_t& offset, const size_t& size) const {
+    WIN32_MEMORY_RANGE_ENTRY range{const_cast<char*>(m_data + offset), std::min(size, m_size - offset)};
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+#else
+MappedFile::MappedFile(const std::string& path) :
+    m_data{nullptr},
+    m_size{0},
+    m_fd{-1}
+{
+    m_fd = open(path.c_str(), O_RDONLY);
+    struct stat info;
+    if (m_fd < 0 || fstat(m_fd, &info) != 0) {
+        throw std::runtime_error("Failed to open '" + path + "' for mapping!");
+    }
+    m_size = info.st_size;
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED) {
+        close(m_fd);
+        throw std::runtime_error("Failed to map '" + path + "'!");
+    }
+    m_data = static_cast<const char*>(data);
+}
+
+MappedFile::~MappedFile() {
+    munmap(const_cast<char*>(m_data), m_size);
+    close(m_fd);
+}
+
+void MappedFile::prefetch(const size_t& offset, const size_t& size) const {
+    // madvise wants page aligned addresses, the kernel reads ahead asynchronously
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t begin = offset / page * page;
+    size_t end = std::min(offset + size, m_size);
+    if (begin < end) {
+        madvise(const_cast<char*>(m_data) + begin, end - begin, MADV_WILLNEED);
+    }
+}
+#endif
+
+const char* MappedFile::data() const {
+    return m_data;
+}
+
+size_t MappedFile::size() const {
+    return m_size;
+}
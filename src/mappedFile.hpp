@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+
+/**
+ * Read only mapping of a whole file. Pages are read by the os on first touch 
+ * and dropped again under memory pressure, so mapped data doesn't count 
+ * against the heap. prefetch() starts reading a range ahead of time.
+**/
+class MappedFile {
+public:
+    MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const;
+    size_t size() const;
+    void prefetch(const size_t& offset, const size_t& size) const;
+
+private:
+    const char* m_data;
+    size_t m_size;
+#ifdef _WIN32
+    void* m_file;
+    void* m_mapping;
+#else
+    int m_fd;
+#endif
+};
@@ -0,0 +1,313 @@
+#include <pairwiseStats.hpp>
+#include <utils.hpp>
+#include <scheduler.hpp>
+#include <spdlog/spdlog.h>
+#include <numeric>
+#include <limits>
+
+static size_t pairIndex(int a, int b, int n) {
+    // upper triangle without diagonal, row by row
+    if (a > b) {
+        std::swap(a, b);
+    }
+    return size_t(a) * (2 * n - a - 1) / 2 + (b - a - 1);
+}
+
+static uint64_t countInversions(std::vector<float>& values, std::vector<float>& scratch) {
+    // bottom up merge sort, counts pairs i < j with values[i] > values[j]
+    uint64_t inversions = 0;
+    size_t n = values.size();
+    scratch.resize(n);
+    for (size_t width = 1; width < n; width *= 2) {
+        for (size_t left = 0; left < n; left += 2 * width) {
+            size_t mid = std::min(left + width, n);
+            size_t right = std::min(left + 2 * width, n);
+            size_t i = left, j = mid, k = left;
+            while (i < mid && j < right) {
+                if (values[j] < values[i]) {
+                    inversions += mid - i;
+                    scratch[k++] = values[j++];
+                }
+                else {
+                    scratch[k++] = values[i++];
+                }
+            }
+            while (i < mid) scratch[k++] = values[i++];
+            while (j < right) scratch[k++] = values[j++];
+        }
+        values.swap(scratch);
+    }
+    return inversions;
+}
+
+static bool crosses(float a0, float b0, float a1, float b1) {
+    return (a0 < a1 && b0 > b1) || (a0 > a1 && b0 < b1);
+}
+
+static double correlation(double n, double sum_a, double sum_b, double sum_aa, double sum_bb, double sum_ab) {
+    double cov = sum_ab - sum_a * sum_b / n;
+    double var_a = sum_aa - sum_a * sum_a / n;
+    double var_b = sum_bb - sum_b * sum_b / n;
+    if (var_a <= 0 || var_b <= 0) {
+        return 0;
+    }
+    return glm::clamp(cov / std::sqrt(var_a * var_b), -1.0, 1.0);
+}
+
+PairwiseStats::PairwiseStats(int num_attributes) :
+    m_num_attributes{num_attributes},
+    m_shift(num_attributes, 0),
+    m_sum(num_attributes, 0),
+    m_sum_sq(num_attributes, 0),
+    m_spearman_dirty{true}
+{
+    for (int a = 0; a < num_attributes; a++) {
+        for (int b = a + 1; b < num_attributes; b++) {
+            m_pairs.push_back({a, b});
+        }
+    }
+    m_sum_prod.assign(m_pairs.size(), 0);
+    m_crossings.assign(m_pairs.size(), 0);
+    m_spearman.assign(m_pairs.size(), 0);
+}
+
+void PairwiseStats::append(const ColumnStore::View& columns) {
+    size_t first = rows();
+    size_t count = columns.rows() - first;
+    if (count == 0 || m_num_attributes == 0) {
+        return;
+    }
+
+    m_columns = columns;
+    for (int a = 0; a < m_num_attributes; a++) {
+        if (first == 0) {
+            m_shift[a] = m_columns(a, 0);
+        }
+        for (size_t i = first; i < first + count; i++) {
+            float value = m_columns(a, i);
+            m_sum[a] += value - m_shift[a];
+            m_sum_sq[a] += double(value - m_shift[a]) * (value - m_shift[a]);
+        }
+    }
+
+    Utils::parallelFor(m_pairs.size(), [&](size_t p) {
+        auto [a, b] = m_pairs[p];
+        for (size_t i = first; i < first + count; i++) {
+            m_sum_prod[p] += double(m_columns(a, i) - m_shift[a]) * (m_columns(b, i) - m_shift[b]);
+        }
+    });
+
+    countCrossings(first);
+    m_spearman_dirty = true;
+}
+
+void PairwiseStats::countCrossings(size_t first) {
+    /**
+     * Two lines cross between axis a and b if their order on a is the opposite 
+     * of their order on b, so the crossings are the inversions of b after sorting 
+     * by a. New rows only need to be checked against all others as long as that 
+     * is cheaper than the O(n log n) recount.
+    **/
+
+    size_t n = rows();
+    size_t added = n - first;
+    bool incremental = first > 0 && added < 4 * std::log2(double(n));
+
+    Utils::parallelFor(m_pairs.size(), [&](size_t p) {
+        auto [a, b] = m_pairs[p];
+        
+        if (incremental) {
+            for (size_t i = first; i < n; i++) {
+                for (size_t j = 0; j < i; j++) {
+                    m_crossings[p] += crosses(m_columns(a, i), m_columns(b, i), m_columns(a, j), m_columns(b, j));
+                }
+            }
+            return;
+        }
+
+        // sort by a, ties by b so lines meeting on axis a don't count
+        std::vector<size_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t i, size_t j) {
+            float a_i = m_columns(a, i);
+            float a_j = m_columns(a, j);
+            return a_i < a_j || (a_i == a_j && m_columns(b, i) < m_columns(b, j));
+        });
+
+        std::vector<float> values(n);
+        std::vector<float> scratch;
+        for (size_t i = 0; i < n; i++) {
+            values[i] = m_columns(b, order[i]);
+        }
+        m_crossings[p] = countInversions(values, scratch);
+    });
+}
+
+void PairwiseStats::updateSpearman() const {
+    if (!m_spearman_dirty) {
+        return;
+    }
+
+    // average ranks per attribute, equal values share a rank
+    size_t n = rows();
+    std::vector<std::vector<double>> ranks(m_num_attributes, std::vector<double>(n));
+    Utils::parallelFor(m_num_attributes, [&](size_t a) {
+        std::vector<size_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t i, size_t j) { return m_columns(a, i) < m_columns(a, j); });
+        
+        for (size_t i = 0; i < n;) {
+            size_t j = i;
+            while (j + 1 < n && m_columns(a, order[j + 1]) == m_columns(a, order[i])) {
+                j++;
+            }
+            for (size_t k = i; k <= j; k++) {
+                ranks[a][order[k]] = (i + j) / 2.0;
+            }
+            i = j + 1;
+        }
+    });
+
+    Utils::parallelFor(m_pairs.size(), [&](size_t p) {
+        const auto& rank_a = ranks[m_pairs[p].first];
+        const auto& rank_b = ranks[m_pairs[p].second];
+        double sum_a = 0, sum_b = 0, sum_aa = 0, sum_bb = 0, sum_ab = 0;
+        for (size_t i = 0; i < n; i++) {
+            sum_a += rank_a[i];
+            sum_b += rank_b[i];
+            sum_aa += rank_a[i] * rank_a[i];
+            sum_bb += rank_b[i] * rank_b[i];
+            sum_ab += rank_a[i] * rank_b[i];
+        }
+        m_spearman[p] = correlation(n, sum_a, sum_b, sum_aa, sum_bb, sum_ab);
+    });
+
+    m_spearman_dirty = false;
+}
+
+double PairwiseStats::pearson(int a, int b) const {
+    if (a == b) {
+        return 1;
+    }
+    size_t p = pairIndex(a, b, m_num_attributes);
+    return correlation(rows(), m_sum[a], m_sum[b], m_sum_sq[a], m_sum_sq[b], m_sum_prod[p]);
+}
+
+double PairwiseStats::spearman(int a, int b) const {
+    if (a == b) {
+        return 1;
+    }
+    updateSpearman();
+    return m_spearman[pairIndex(a, b, m_num_attributes)];
+}
+
+uint64_t PairwiseStats::crossings(int a, int b) const {
+    if (a == b) {
+        return 0;
+    }
+    return m_crossings[pairIndex(a, b, m_num_attributes)];
+}
+
+size_t PairwiseStats::rows() const {
+    return m_columns.rows();
+}
+
+double PairwiseStats::distance(const OrderMetric& metric, int a, int b) const {
+    // axis can't be inverted, so negative correlation is as bad as it gets
+    double n = rows();
+    switch (metric) {
+        case OrderMetric::CROSSINGS:
+            return crossings(a, b) / std::max(n * (n - 1) / 2, 1.0);
+        case OrderMetric::PEARSON:
+            return (1 - pearson(a, b)) / 2;
+        case OrderMetric::SPEARMAN:
+            return (1 - spearman(a, b)) / 2;
+    }
+    return 0;
+}
+
+double PairwiseStats::pathCost(const OrderMetric& metric, const std::vector<int>& order) const {
+    double cost = 0;
+    for (int i = 0; i + 1 < order.size(); i++) {
+        cost += distance(metric, order[i], order[i + 1]);
+    }
+    return cost;
+}
+
+std::vector<int> PairwiseStats::solveOrder(const OrderMetric& metric) const {
+    /**
+     * Open path through all attributes with minimal summed distance of neighbours.
+     * Nearest neighbour from every start, best one is refined with 2-opt.
+    **/
+
+    int n = m_num_attributes;
+    std::vector<double> dist(n * n, 0);
+    for (int a = 0; a < n; a++) {
+        for (int b = 0; b < n; b++) {
+            dist[a * n + b] = distance(metric, a, b);
+        }
+    }
+
+    // every start is independent, ties go to the lower start as in a serial loop
+    using Path = std::pair<double, std::vector<int>>;
+    auto nearest = [&](size_t start) {
+        std::vector<int> path{int(start)};
+        std::vector<bool> used(n, false);
+        used[start] = true;
+        for (int step = 1; step < n; step++) {
+            int next = -1;
+            for (int c = 0; c < n; c++) {
+                if (!used[c] && (next < 0 || dist[path.back() * n + c] < dist[path.back() * n + next])) {
+                    next = c;
+                }
+            }
+            used[next] = true;
+            path.push_back(next);
+        }
+        
+        double cost = 0;
+        for (int i = 0; i + 1 < n; i++) {
+            cost += dist[path[i] * n + path[i + 1]];
+        }
+        return Path{cost, path};
+    };
+    auto shorter = [](const Path& a, const Path& b) {
+        if (a.second.empty() || b.second.empty()) {
+            return a.second.empty() ? b : a;
+        }
+        return a.first <= b.first ? a : b;
+    };
+    auto best = Scheduler::instance().reduce(n, Path{0, {}}, nearest, shorter).second;
+
+    // reverse segments [i, j] as long as it shortens the path, ends have no outer edge
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        for (int i = 0; i < n - 1; i++) {
+            for (int j = i + 1; j < n; j++) {
+                double before = 0, after = 0;
+                if (i > 0) {
+                    before += dist[best[i - 1] * n + best[i]];
+                    after += dist[best[i - 1] * n + best[j]];
+                }
+                if (j < n - 1) {
+                    before += dist[best[j] * n + best[j + 1]];
+                    after += dist[best[i] * n + best[j + 1]];
+                }
+                if (after + 1e-12 < before) {
+                    std::reverse(best.begin() + i, best.begin() + j + 1);
+                    improved = true;
+                }
+            }
+        }
+    }
+
+    return best;
+}
+
+void PairwiseStats::report() const {
+    for (const auto& [a, b] : m_pairs) {
+        spdlog::info("Attributes {} - {}: pearson {:.3f}, spearman {:.3f}, {} crossings", 
+            a, b, pearson(a, b), spearman(a, b), crossings(a, b));
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <columnStore.hpp>
+
+enum class OrderMetric {
+    CROSSINGS, // exact number of line crossings between two axis
+    PEARSON,
+    SPEARMAN
+};
+
+/**
+ * Pairwise statistics of all attributes, used to find axis orders with few 
+ * line crossings. Pearson sums and crossing counts are updated incrementally 
+ * when rows get appended, rank based Spearman is recomputed lazily since every 
+ * new row can shift all ranks. Values are read through the shared column store.
+**/
+class PairwiseStats {
+public:
+    PairwiseStats(int num_attributes = 0);
+    void append(const ColumnStore::View& columns); // rows of the view beyond the counted ones
+    double pearson(int a, int b) const;
+    double spearman(int a, int b) const;
+    uint64_t crossings(int a, int b) const;
+    size_t rows() const;
+    std::vector<int> solveOrder(const OrderMetric& metric) const;
+    void report() const;
+
+private:
+    double distance(const OrderMetric& metric, int a, int b) const;
+    double pathCost(const OrderMetric& metric, const std::vector<int>& order) const;
+    void countCrossings(size_t first);
+    void updateSpearman() const;
+
+    int m_num_attributes;
+    std::vector<std::pair<int, int>> m_pairs; // all a < b, work items for parallel updates
+    ColumnStore::View m_columns;
+    
+    // sums of values shifted by the first row, keeps cancellation small
+    std::vector<float> m_shift;
+    std::vector<double> m_sum;
+    std::vector<double> m_sum_sq;
+    std::vector<double> m_sum_prod; // per pair
+    std::vector<uint64_t> m_crossings; // per pair
+    
+    mutable std::vector<double> m_spearman; // per pair, cached until next append
+    mutable bool m_spearman_dirty;
+};
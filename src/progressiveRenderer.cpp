@@ -0,0 +1,134 @@
+#include <progressiveRenderer.hpp>
+#include <algorithm>
+
+ProgressiveRenderer::ProgressiveRenderer(const float& budgetMs, const size_t& chunkLines) :
+    m_query_head{0},
+    m_budget_ms{budgetMs},
+    m_ns_per_index{0},
+    m_chunk_lines{std::max<size_t>(chunkLines, 1)},
+    m_chunk_size{0},
+    m_cursor{0},
+    m_count{0}
+{
+    glCreateQueries(GL_TIME_ELAPSED, QUERY_COUNT, m_queries);
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        m_query_indicies[i] = 0;
+        m_query_pending[i] = false;
+    }
+}
+
+ProgressiveRenderer::ProgressiveRenderer(ProgressiveRenderer&& other) noexcept :
+    m_query_head{other.m_query_head},
+    m_budget_ms{other.m_budget_ms},
+    m_ns_per_index{other.m_ns_per_index},
+    m_chunk_lines{other.m_chunk_lines},
+    m_chunk_size{other.m_chunk_size},
+    m_cursor{other.m_cursor},
+    m_count{other.m_count}
+{
+    // queries change owner, deleting name 0 is ignored
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        m_queries[i] = other.m_queries[i];
+        m_query_indicies[i] = other.m_query_indicies[i];
+        m_query_pending[i] = other.m_query_pending[i];
+        other.m_queries[i] = 0;
+        other.m_query_pending[i] = false;
+    }
+}
+
+ProgressiveRenderer::~ProgressiveRenderer() {
+    glDeleteQueries(QUERY_COUNT, m_queries);
+}
+
+ProgressiveRenderer& ProgressiveRenderer::operator=(ProgressiveRenderer&& other) noexcept {
+    // other deletes the queries of this one
+    std::swap(m_queries, other.m_queries);
+    std::swap(m_query_indicies, other.m_query_indicies);
+    std::swap(m_query_pending, other.m_query_pending);
+    m_query_head = other.m_query_head;
+    m_budget_ms = other.m_budget_ms;
+    m_ns_per_index = other.m_ns_per_index;
+    m_chunk_lines = other.m_chunk_lines;
+    m_chunk_size = other.m_chunk_size;
+    m_cursor = other.m_cursor;
+    m_count = other.m_count;
+    return *this;
+}
+
+void ProgressiveRenderer::restart(const size_t& count, const size_t& indiciesPerLine) {
+    // start new accumulation, gpu cost estimate is kept since it barely changes
+    m_cursor = 0;
+    m_count = count;
+    m_chunk_size = std::max<size_t>(indiciesPerLine, 2) * m_chunk_lines;
+}
+
+bool ProgressiveRenderer::done() const {
+    return m_cursor >= m_count;
+}
+
+void ProgressiveRenderer::collectTimings() {
+    // read back all finished queries without stalling
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        if (!m_query_pending[i]) {
+            continue;
+        }
+
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(m_queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE) {
+            continue;
+        }
+        
+        GLuint64 elapsed_ns = 0;
+        glGetQueryObjectui64v(m_queries[i], GL_QUERY_RESULT, &elapsed_ns);
+        m_query_pending[i] = false;
+
+        if (m_query_indicies[i] == 0) {
+            continue;
+        }
+        
+        // exponential smoothing, frame timings are noisy
+        double measured = double(elapsed_ns) / m_query_indicies[i];
+        m_ns_per_index = m_ns_per_index == 0 ? measured : 0.7 * m_ns_per_index + 0.3 * measured;
+    }
+}
+
+void ProgressiveRenderer::render(const std::function<void(const DrawRange&)>& drawChunk) {
+    collectTimings();
+    if (done()) {
+        return;
+    }
+    
+    // without any timing feedback yet only a single chunk is rendered
+    size_t chunks = 1;
+    if (m_ns_per_index > 0) {
+        double budget_ns = m_budget_ms * 1e6;
+        chunks = std::max<size_t>(size_t(budget_ns / (m_ns_per_index * m_chunk_size)), 1);
+    }
+    
+    // only time this frame if the query slot already delivered its last result
+    int query = m_query_head;
+    bool timed = !m_query_pending[query];
+    if (timed) {
+        glBeginQuery(GL_TIME_ELAPSED, m_queries[query]);
+    }
+    
+    size_t drawn = 0;
+    for (size_t i = 0; i < chunks && !done(); i++) {
+        auto range = DrawRange{m_cursor, std::min(m_chunk_size, m_count - m_cursor)};
+        drawChunk(range);
+        m_cursor += range.count;
+        drawn += range.count;
+    }
+    
+    if (timed) {
+        glEndQuery(GL_TIME_ELAPSED);
+        m_query_indicies[query] = drawn;
+        m_query_pending[query] = true;
+        m_query_head = (m_query_head + 1) % QUERY_COUNT;
+    }
+
+    if (done()) {
+        spdlog::debug("Progressive rendering converged, {:.2f} ns per index", m_ns_per_index);
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+#include <functional>
+#include <structs.hpp>
+
+class ProgressiveRenderer {
+public:
+    ProgressiveRenderer(const float& budgetMs, const size_t& chunkLines);
+    ProgressiveRenderer(const ProgressiveRenderer&) = delete;
+    ProgressiveRenderer(ProgressiveRenderer&& other) noexcept;
+    ~ProgressiveRenderer();
+    ProgressiveRenderer& operator=(const ProgressiveRenderer&) = delete;
+    ProgressiveRenderer& operator=(ProgressiveRenderer&& other) noexcept;
+    void restart(const size_t& count, const size_t& indiciesPerLine);
+    void render(const std::function<void(const DrawRange&)>& drawChunk);
+    bool done() const;
+
+private:
+    void collectTimings();
+    
+    static const int QUERY_COUNT = 4;
+    
+    GLuint m_queries[QUERY_COUNT]; // ring of gpu timer queries, results arrive frames later
+    size_t m_query_indicies[QUERY_COUNT]; // number of indicies drawn while query was active
+    bool m_query_pending[QUERY_COUNT];
+    int m_query_head;
+    
+    float m_budget_ms;
+    double m_ns_per_index; // smoothed gpu cost, 0 as long as no timing arrived
+    size_t m_chunk_lines;
+    size_t m_chunk_size; // indicies per chunk, only whole lines
+    size_t m_cursor;
+    size_t m_count;
+};
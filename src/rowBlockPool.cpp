@@ -0,0 +1,97 @@
+#include <rowBlockPool.hpp>
+#include <utils.hpp>
+#include <spdlog/spdlog.h>
+
+RowBlockPool::RowBlockPool() :
+    m_block_rows{1},
+    m_row_values{0},
+    m_rows{0},
+    m_table_ssbo{"RowBlockPool", sizeof(int)}, // shaders declare the table even if nothing is paged
+    m_tick{0},
+    m_uploads{0},
+    m_evictions{0}
+{}
+
+RowBlockPool::RowBlockPool(const size_t& blockRows, const size_t& rowValues, const size_t& slots, const Fill& fill, const Prefetch& prefetch) :
+    m_block_rows{blockRows},
+    m_row_values{rowValues},
+    m_rows{0},
+    m_fill{fill},
+    m_prefetch{prefetch},
+    m_data{"RowBlockPool", GLsizeiptr(slots * blockRows * rowValues * sizeof(float)), nullptr, GL_DYNAMIC_STORAGE_BIT},
+    m_slot_block(slots, FREE),
+    m_slot_use(slots, 0),
+    m_staging(blockRows * rowValues),
+    m_tick{0},
+    m_uploads{0},
+    m_evictions{0}
+{
+    resize(0);
+}
+
+void RowBlockPool::resize(const size_t& rows) {
+    m_rows = rows;
+    m_table.assign(blocks(), -1);
+    std::fill(m_slot_block.begin(), m_slot_block.end(), FREE);
+    std::fill(m_slot_use.begin(), m_slot_use.end(), 0);
+    m_table_ssbo = gl::Buffer("RowBlockPool", std::max<size_t>(m_table.size(), 1) * sizeof(int), m_table.empty() ? nullptr : m_table.data(), GL_DYNAMIC_STORAGE_BIT);
+}
+
+int RowBlockPool::acquire(const size_t& block) {
+    m_tick++;
+    int slot = m_table[block];
+    if (slot >= 0) {
+        m_slot_use[slot] = m_tick;
+        return slot;
+    }
+    
+    // free slots have the oldest tick, otherwise the least recently used block goes
+    slot = std::min_element(m_slot_use.begin(), m_slot_use.end()) - m_slot_use.begin();
+    size_t evicted = m_slot_block[slot];
+    if (evicted != FREE) {
+        m_table[evicted] = -1;
+        glNamedBufferSubData(m_table_ssbo.id(), evicted * sizeof(int), sizeof(int), &m_table[evicted]);
+        m_evictions++;
+    }
+
+    // draws already submitted still see the old contents, updates are ordered
+    size_t first = block * m_block_rows;
+    size_t count = std::min(m_block_rows, m_rows - first);
+    m_fill(first, count, m_staging.data());
+    glNamedBufferSubData(m_data.id(), slot * m_block_rows * m_row_values * sizeof(float), count * m_row_values * sizeof(float), m_staging.data());
+    
+    m_table[block] = slot;
+    m_slot_block[slot] = block;
+    m_slot_use[slot] = m_tick;
+    glNamedBufferSubData(m_table_ssbo.id(), block * sizeof(int), sizeof(int), &m_table[block]);
+    m_uploads++;
+    return slot;
+}
+
+void RowBlockPool::prefetch(const size_t& block) const {
+    if (block < m_table.size() && m_table[block] < 0 && m_prefetch) {
+        size_t first = block * m_block_rows;
+        m_prefetch(first, std::min(m_block_rows, m_rows - first));
+    }
+}
+
+void RowBlockPool::bind(const GLuint& dataBinding, const GLuint& tableBinding) const {
+    if (m_data.id() != 0) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, dataBinding, m_data.id());
+    }
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, tableBinding, m_table_ssbo.id());
+}
+
+size_t RowBlockPool::blocks() const {
+    return (m_rows + m_block_rows - 1) / m_block_rows;
+}
+
+size_t RowBlockPool::blockRows() const {
+    return m_block_rows;
+}
+
+void RowBlockPool::report() const {
+    size_t resident = std::count_if(m_slot_block.begin(), m_slot_block.end(), [](size_t block) { return block != FREE; });
+    spdlog::info("Row blocks: {} of {} resident in {} slots ({} kb), {} uploads, {} evictions", 
+        resident, blocks(), m_slot_block.size(), m_data.size() / 1024, m_uploads, m_evictions);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <gl/resource.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * Out of core data rows: rows are split into fixed size blocks, only a fixed 
+ * number of them (the budget) is resident in slots of one gpu buffer. A 
+ * missing block evicts the least recently used one. A table maps every block 
+ * to its slot or -1, shaders translate rows through it.
+**/
+class RowBlockPool {
+public:
+    using Fill = std::function<void(const size_t& first, const size_t& count, float* rows)>;
+    using Prefetch = std::function<void(const size_t& first, const size_t& count)>;
+
+    RowBlockPool();
+    RowBlockPool(const size_t& blockRows, const size_t& rowValues, const size_t& slots, const Fill& fill, const Prefetch& prefetch);
+    void resize(const size_t& rows); // drops all resident blocks
+    int acquire(const size_t& block); // slot of block, filled if it wasn't resident
+    void prefetch(const size_t& block) const; // hint for a block needed soon
+    void bind(const GLuint& dataBinding, const GLuint& tableBinding) const;
+    size_t blocks() const;
+    size_t blockRows() const;
+    void report() const;
+
+private:
+    static constexpr size_t FREE = SIZE_MAX;
+
+    size_t m_block_rows;
+    size_t m_row_values;
+    size_t m_rows;
+    Fill m_fill;
+    Prefetch m_prefetch;
+    gl::Buffer m_data; // slots * block rows * row values floats
+    gl::Buffer m_table_ssbo;
+    std::vector<int> m_table; // block -> slot
+    std::vector<size_t> m_slot_block; // slot -> block
+    std::vector<uint64_t> m_slot_use; // tick of last acquire, 0 for free slots
+    std::vector<float> m_staging;
+    uint64_t m_tick;
+    size_t m_uploads;
+    size_t m_evictions;
+};
@@ -0,0 +1,266 @@
+#include <scheduler.hpp>
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <cstdint>
+#include <cmath>
+
+namespace {
+    // queue of the calling thread and priority of the task it runs
+    thread_local size_t t_worker = SIZE_MAX;
+    thread_local TaskPriority t_priority = TaskPriority::INTERACTIVE;
+}
+
+bool TaskGroup::done() const {
+    return m_pending == 0;
+}
+
+Scheduler& Scheduler::instance() {
+    // the caller of wait() helps, so one core is left to it
+    static Scheduler scheduler(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+    return scheduler;
+}
+
+Scheduler::Scheduler(const size_t& workers) :
+    m_queued{0},
+    m_stop{false}
+{
+    for (size_t i = 0; i <= workers; i++) {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < workers; i++) {
+        m_threads.emplace_back(&Scheduler::workerLoop, this, i);
+    }
+}
+
+Scheduler::~Scheduler() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void Scheduler::submit(std::function<void()> task, TaskGroup& group, const TaskPriority& priority) {
+    group.m_pending++;
+    auto& queue = *m_queues[ownQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks[int(priority)].push_back(Task{std::move(task), &group, priority});
+    }
+    m_queued++;
+    
+    // empty lock orders the increment before a sleeping worker checks it
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    }
+    m_wake.notify_one();
+}
+
+void Scheduler::submit(std::function<void()> task, TaskGroup& group) {
+    submit(std::move(task), group, currentPriority());
+}
+
+void Scheduler::wait(TaskGroup& group) {
+    // help instead of blocking, interactive waiters don't pick up background work
+    auto lowest = currentPriority();
+    while (!group.done()) {
+        if (!runOne(lowest)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+size_t Scheduler::workers() const {
+    return m_threads.size();
+}
+
+TaskPriority Scheduler::currentPriority() {
+    return t_priority;
+}
+
+size_t Scheduler::chunks(const size_t& count) const {
+    return std::min(count, (workers() + 1) * 4);
+}
+
+size_t Scheduler::ownQueue() const {
+    return t_worker < m_threads.size() ? t_worker : m_queues.size() - 1;
+}
+
+bool Scheduler::take(const TaskPriority& lowest, Task& task) {
+    if (m_queued == 0) {
+        return false;
+    }
+
+    // own queue newest first (still in cache), others oldest first (usually the biggest piece)
+    size_t own = ownQueue();
+    for (int priority = 0; priority <= int(lowest); priority++) {
+        for (size_t k = 0; k < m_queues.size(); k++) {
+            auto& queue = *m_queues[(own + k) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            auto& tasks = queue.tasks[priority];
+            if (tasks.empty()) {
+                continue;
+            }
+            task = k == 0 ? tasks.pop_back() : tasks.pop_front();
+            m_queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Scheduler::runOne(const TaskPriority& lowest) {
+    Task task;
+    if (!take(lowest, task)) {
+        return false;
+    }
+    execute(task);
+    return true;
+}
+
+void Scheduler::execute(Task& task) {
+    // nested submits inherit the priority, group may be gone after the decrement
+    auto prev = t_priority;
+    t_priority = task.priority;
+    task.func();
+    t_priority = prev;
+    task.group->m_pending--;
+}
+
+bool Scheduler::TaskRing::empty() const {
+    return m_count == 0;
+}
+
+void Scheduler::TaskRing::push_back(Task task) {
+    // full -> double the slots, tasks keep their order from the front
+    if (m_count == m_slots.size()) {
+        std::vector<Task> slots(std::max<size_t>(m_slots.size() * 2, 16));
+        for (size_t i = 0; i < m_count; i++) {
+            slots[i] = std::move(m_slots[(m_head + i) % m_slots.size()]);
+        }
+        m_slots.swap(slots);
+        m_head = 0;
+    }
+    m_slots[(m_head + m_count) % m_slots.size()] = std::move(task);
+    m_count++;
+}
+
+Scheduler::Task Scheduler::TaskRing::pop_back() {
+    m_count--;
+    return std::move(m_slots[(m_head + m_count) % m_slots.size()]);
+}
+
+Scheduler::Task Scheduler::TaskRing::pop_front() {
+    Task task = std::move(m_slots[m_head]);
+    m_head = (m_head + 1) % m_slots.size();
+    m_count--;
+    return task;
+}
+
+void Scheduler::workerLoop(const size_t& index) {
+    t_worker = index;
+    while (true) {
+        if (runOne(TaskPriority::BACKGROUND)) {
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_wake.wait(lock, [this]() { return m_stop || m_queued > 0; });
+        if (m_stop) {
+            return;
+        }
+    }
+}
+
+void Scheduler::benchmark() {
+    /**
+     * Micro benchmarks run with --bench-scheduler: task overhead, speedup of 
+     * even and skewed loops, reduce and how long interactive work waits 
+     * behind a flooded background queue.
+    **/
+    
+    using clock = std::chrono::steady_clock;
+    auto elapsed = [](const clock::time_point& start) {
+        return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    };
+    auto& scheduler = instance();
+    spdlog::info("Scheduler benchmark, {} workers + caller", scheduler.workers());
+
+    // submit & run overhead
+    const size_t tasks = 100000;
+    TaskGroup group;
+    auto start = clock::now();
+    for (size_t i = 0; i < tasks; i++) {
+        scheduler.submit([]() {}, group);
+    }
+    scheduler.wait(group);
+    spdlog::info("  {} empty tasks: {:.0f} ns per task", tasks, elapsed(start) * 1e6 / tasks);
+
+    // same cost per index
+    const size_t count = 1 << 22;
+    std::vector<float> out(count);
+    auto even = [&](size_t i) {
+        float value = float(i);
+        for (int k = 0; k < 16; k++) {
+            value = std::sqrt(value + k);
+        }
+        out[i] = value;
+    };
+    start = clock::now();
+    for (size_t i = 0; i < count; i++) {
+        even(i);
+    }
+    double serial = elapsed(start);
+    start = clock::now();
+    scheduler.parallelFor(count, even);
+    double parallel = elapsed(start);
+    spdlog::info("  parallelFor even: serial {:.2f} ms, parallel {:.2f} ms, x{:.2f}", serial, parallel, serial / parallel);
+    
+    // cost grows with the index, last chunks are the expensive ones
+    const size_t skewed_count = 4096;
+    auto skewed = [&](size_t i) {
+        float value = 0;
+        for (size_t k = 0; k < i * 64; k++) {
+            value += std::sqrt(float(k));
+        }
+        out[i] = value;
+    };
+    start = clock::now();
+    for (size_t i = 0; i < skewed_count; i++) {
+        skewed(i);
+    }
+    serial = elapsed(start);
+    start = clock::now();
+    scheduler.parallelFor(skewed_count, skewed);
+    double skewed_parallel = elapsed(start);
+    spdlog::info("  parallelFor skewed: serial {:.2f} ms, parallel {:.2f} ms, x{:.2f}", serial, skewed_parallel, serial / skewed_parallel);
+    
+    // sum of the even loop results
+    start = clock::now();
+    double expected = 0;
+    for (size_t i = 0; i < count; i++) {
+        expected += out[i];
+    }
+    serial = elapsed(start);
+    start = clock::now();
+    double sum = scheduler.reduce(count, 0.0, [&](size_t i) { return double(out[i]); }, [](double a, double b) { return a + b; });
+    spdlog::info("  reduce: serial {:.2f} ms, parallel {:.2f} ms, relative error {:.1e}", serial, elapsed(start), std::abs(sum - expected) / expected);
+
+    // interactive loop submitted while every worker has plenty of 1ms background tasks
+    TaskGroup background;
+    auto spin = [&elapsed]() {
+        auto begin = clock::now();
+        while (elapsed(begin) < 1.0) {}
+    };
+    size_t flood = scheduler.workers() * 64;
+    for (size_t i = 0; i < flood; i++) {
+        scheduler.submit(spin, background, TaskPriority::BACKGROUND);
+    }
+    start = clock::now();
+    scheduler.parallelFor(count, even);
+    spdlog::info("  parallelFor behind {} background tasks: {:.2f} ms (idle {:.2f} ms)", flood, elapsed(start), parallel);
+    scheduler.wait(background);
+}
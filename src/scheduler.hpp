@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum class TaskPriority {
+    INTERACTIVE = 0, // a frame or an input event waits for the result
+    BACKGROUND = 1   // statistics and other results nobody waits on yet
+};
+
+/**
+ * Counts unfinished tasks submitted with it. done() never blocks, so the 
+ * render thread can poll a group once per frame instead of waiting on it.
+**/
+class TaskGroup {
+public:
+    bool done() const;
+
+private:
+    friend class Scheduler;
+    std::atomic<size_t> m_pending{0};
+};
+
+/**
+ * Work stealing job system shared by everything cpu heavy so subsystems 
+ * don't oversubscribe the machine with their own threads. Every worker owns 
+ * a queue per priority, pops its newest task and steals the oldest one of 
+ * another worker when its own queue is empty. Interactive tasks of all 
+ * queues are taken before any background task. Threads outside of the pool 
+ * (render, loader) share one more queue and help executing while they wait.
+**/
+class Scheduler {
+public:
+    static Scheduler& instance();
+    ~Scheduler();
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    void submit(std::function<void()> task, TaskGroup& group, const TaskPriority& priority);
+    void submit(std::function<void()> task, TaskGroup& group); // priority of the calling task
+    void wait(TaskGroup& group);
+
+    // calls func for every index in [0, count), returns once all are done
+    template<typename Func>
+    void parallelFor(const size_t& count, const Func& func);
+
+    template<typename T, typename Map, typename Combine>
+    T reduce(const size_t& count, const T& identity, const Map& map, const Combine& combine);
+
+    size_t workers() const;
+    static TaskPriority currentPriority();
+    static void benchmark();
+
+private:
+    struct Task {
+        std::function<void()> func;
+        TaskGroup* group;
+        TaskPriority priority;
+    };
+
+    /**
+     * Double ended ring of tasks. Unlike a deque it keeps its slots when 
+     * tasks are taken, so submitting in a steady loop doesn't allocate.
+    **/
+    class TaskRing {
+    public:
+        bool empty() const;
+        void push_back(Task task);
+        Task pop_back();
+        Task pop_front();
+
+    private:
+        std::vector<Task> m_slots;
+        size_t m_head = 0;
+        size_t m_count = 0;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        TaskRing tasks[2]; // indexed by priority
+    };
+
+    Scheduler(const size_t& workers);
+    size_t chunks(const size_t& count) const;
+    size_t ownQueue() const;
+    bool take(const TaskPriority& lowest, Task& task);
+    bool runOne(const TaskPriority& lowest);
+    void execute(Task& task);
+    void workerLoop(const size_t& index);
+
+    std::vector<std::unique_ptr<Queue>> m_queues; // one per worker, last one for outside threads
+    std::vector<std::thread> m_threads;
+    std::atomic<size_t> m_queued;
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_wake;
+    bool m_stop;
+};
+
+template<typename Func>
+void Scheduler::parallelFor(const size_t& count, const Func& func) {
+    /**
+     * Splits [0, count) into a few chunks per thread, enough for stealing to 
+     * balance uneven work per index. The first chunk runs on the caller. 
+     * Tasks only capture two words, small enough for std::function to store 
+     * them without allocating.
+    **/
+
+    size_t parts = chunks(count);
+    if (parts <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            func(i);
+        }
+        return;
+    }
+    
+    auto run = [&](size_t part) {
+        for (size_t i = count * part / parts; i < count * (part + 1) / parts; i++) {
+            func(i);
+        }
+    };
+
+    TaskGroup group;
+    for (size_t part = 1; part < parts; part++) {
+        submit([&run, part]() { run(part); }, group);
+    }
+    run(0);
+    wait(group);
+}
+
+template<typename T, typename Map, typename Combine>
+T Scheduler::reduce(const size_t& count, const T& identity, const Map& map, const Combine& combine) {
+    // partials are combined in chunk order -> result doesn't depend on scheduling
+    size_t parts = chunks(count);
+    std::vector<T> partial(parts, identity);
+    parallelFor(parts, [&](size_t p) {
+        for (size_t i = count * p / parts; i < count * (p + 1) / parts; i++) {
+            partial[p] = combine(partial[p], map(i));
+        }
+    });
+
+    T result = identity;
+    for (const auto& value : partial) {
+        result = combine(result, value);
+    }
+    return result;
+}
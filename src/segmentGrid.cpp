@@ -0,0 +1,103 @@
+#include <segmentGrid.hpp>
+#include <utils.hpp>
+#include <atomic>
+#include <limits>
+
+static float distanceToSegment(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b) {
+    glm::vec2 ab = b - a;
+    float length = glm::dot(ab, ab);
+    float t = length > 0 ? glm::clamp(glm::dot(p - a, ab) / length, 0.0f, 1.0f) : 0.0f;
+    return glm::distance(p, a + t * ab);
+}
+
+std::vector<GridSegment>& SegmentGrid::segments() {
+    return m_segments;
+}
+
+size_t SegmentGrid::cells() const {
+    return size_t(m_dims.x) * m_dims.y;
+}
+
+glm::ivec2 SegmentGrid::cell(const glm::vec2& pos) const {
+    glm::ivec2 c = glm::ivec2(glm::floor((pos - m_min) / m_cell_size));
+    return glm::clamp(c, glm::ivec2(0), m_dims - 1);
+}
+
+void SegmentGrid::build(const float& cellSize) {
+    m_min = glm::vec2(std::numeric_limits<float>::max());
+    glm::vec2 max = glm::vec2(std::numeric_limits<float>::lowest());
+    for (const auto& segment : m_segments) {
+        m_min = glm::min(m_min, glm::min(segment.a, segment.b));
+        max = glm::max(max, glm::max(segment.a, segment.b));
+    }
+    if (m_segments.empty()) {
+        m_min = max = glm::vec2(0);
+    }
+
+    // requested size unless that exceeds the cell limit
+    glm::vec2 extent = max - m_min;
+    m_cell_size = glm::max(glm::vec2(cellSize), extent / float(MAX_DIM));
+    m_cell_size = glm::max(m_cell_size, glm::vec2(1e-6f));
+    m_dims = glm::clamp(glm::ivec2(glm::ceil(extent / m_cell_size)), glm::ivec2(1), glm::ivec2(MAX_DIM));
+
+    // count segments per cell, then fill cells through per cell cursors - both in parallel
+    size_t chunks = (m_segments.size() + CHUNK - 1) / CHUNK;
+    std::vector<std::atomic<uint32_t>> cursors(cells());
+    auto forEachCell = [this](const GridSegment& segment, const auto& func) {
+        glm::ivec2 lo = cell(glm::min(segment.a, segment.b));
+        glm::ivec2 hi = cell(glm::max(segment.a, segment.b));
+        for (int y = lo.y; y <= hi.y; y++) {
+            for (int x = lo.x; x <= hi.x; x++) {
+                func(size_t(y) * m_dims.x + x);
+            }
+        }
+    };
+
+    Utils::parallelFor(chunks, [&](size_t chunk) {
+        size_t end = std::min((chunk + 1) * CHUNK, m_segments.size());
+        for (size_t i = chunk * CHUNK; i < end; i++) {
+            forEachCell(m_segments[i], [&](size_t c) { cursors[c]++; });
+        }
+    });
+
+    m_cell_start.resize(cells() + 1);
+    m_cell_start[0] = 0;
+    for (size_t c = 0; c < cells(); c++) {
+        m_cell_start[c + 1] = m_cell_start[c] + cursors[c];
+        cursors[c] = m_cell_start[c];
+    }
+
+    m_items.resize(m_cell_start.back());
+    Utils::parallelFor(chunks, [&](size_t chunk) {
+        size_t end = std::min((chunk + 1) * CHUNK, m_segments.size());
+        for (size_t i = chunk * CHUNK; i < end; i++) {
+            forEachCell(m_segments[i], [&](size_t c) { m_items[cursors[c]++] = i; });
+        }
+    });
+}
+
+int SegmentGrid::nearest(const glm::vec2& pos, const float& tolerance) const {
+    if (m_segments.empty()) {
+        return -1;
+    }
+
+    // cells are filled in parallel -> lower line wins ties to stay deterministic
+    int result = -1;
+    float best = tolerance;
+    glm::ivec2 lo = cell(pos - tolerance);
+    glm::ivec2 hi = cell(pos + tolerance);
+    for (int y = lo.y; y <= hi.y; y++) {
+        for (int x = lo.x; x <= hi.x; x++) {
+            size_t c = size_t(y) * m_dims.x + x;
+            for (uint32_t i = m_cell_start[c]; i < m_cell_start[c + 1]; i++) {
+                const auto& segment = m_segments[m_items[i]];
+                float distance = distanceToSegment(pos, segment.a, segment.b);
+                if (distance < best || (distance == best && result >= 0 && segment.line < result)) {
+                    best = distance;
+                    result = segment.line;
+                }
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+struct GridSegment {
+    glm::vec2 a;
+    glm::vec2 b;
+    int line; // row the segment belongs to
+};
+
+/**
+ * Uniform grid over straight line segments for nearest line lookups. Segments 
+ * are binned into every cell their bounding box touches, a query only tests 
+ * the cells within the tolerance around the point.
+**/
+class SegmentGrid {
+public:
+    std::vector<GridSegment>& segments(); // fill, then build()
+    void build(const float& cellSize);
+    int nearest(const glm::vec2& pos, const float& tolerance) const; // line id, -1 if none within tolerance
+    size_t cells() const;
+
+private:
+    glm::ivec2 cell(const glm::vec2& pos) const;
+
+    static const int MAX_DIM = 2048; // cells per dimension
+    static const size_t CHUNK = 4096; // segments per parallel work item
+
+    std::vector<GridSegment> m_segments;
+    std::vector<uint32_t> m_cell_start; // prefix sum, items of cell i are [start[i], start[i + 1])
+    std::vector<uint32_t> m_items; // segment indicies
+    glm::vec2 m_min;
+    glm::vec2 m_cell_size;
+    glm::ivec2 m_dims;
+};
@@ -0,0 +1,138 @@
+#include <stratifiedSample.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <numeric>
+
+StratifiedSample::StratifiedSample() : 
+    StratifiedSample(1, 0, 0) 
+{}
+
+StratifiedSample::StratifiedSample(const int& attributes, const int& attribute, const size_t& size) :
+    m_num_attributes{attributes},
+    m_attribute{attribute},
+    m_size{size},
+    m_rows{0},
+    m_categorical{false},
+    m_random{42} // same preview on every run
+{}
+
+void StratifiedSample::initializeStrata(const float* rows, const size_t& count) {
+    std::vector<float> values(count);
+    for (size_t i = 0; i < count; i++) {
+        values[i] = rows[i * m_num_attributes + m_attribute];
+    }
+    std::sort(values.begin(), values.end());
+
+    // few distinct values -> classes, values of later rows that aren't a class go to the nearest one
+    std::vector<float> distinct(values.begin(), std::unique(values.begin(), values.end()));
+    m_categorical = distinct.size() <= MAX_CLASSES;
+    if (m_categorical) {
+        m_bounds = distinct;
+    }
+    else {
+        for (int q = 1; q < QUANTILES; q++) {
+            m_bounds.push_back(values[count * q / QUANTILES]);
+        }
+        m_bounds.erase(std::unique(m_bounds.begin(), m_bounds.end()), m_bounds.end());
+    }
+    m_strata.resize(m_categorical ? m_bounds.size() : m_bounds.size() + 1, Stratum{{}, 0});
+}
+
+int StratifiedSample::stratum(const float& value) const {
+    int upper = std::lower_bound(m_bounds.begin(), m_bounds.end(), value) - m_bounds.begin();
+    if (!m_categorical) {
+        return upper;
+    }
+    if (upper == m_bounds.size() || (upper > 0 && value - m_bounds[upper - 1] < m_bounds[upper] - value)) {
+        return upper - 1;
+    }
+    return upper;
+}
+
+void StratifiedSample::append(const float* rows, const size_t& count) {
+    if (m_size == 0 || count == 0) {
+        m_rows += count;
+        return;
+    }
+    if (m_strata.empty()) {
+        initializeStrata(rows, count);
+    }
+
+    // algorithm R per stratum, every reservoir can hold the whole sample
+    for (size_t i = 0; i < count; i++) {
+        auto& stratum = m_strata[this->stratum(rows[i * m_num_attributes + m_attribute])];
+        int row = int(m_rows + i);
+        stratum.seen++;
+        if (stratum.reservoir.size() < m_size) {
+            stratum.reservoir.push_back(row);
+            continue;
+        }
+        size_t slot = std::uniform_int_distribution<size_t>(0, stratum.seen - 1)(m_random);
+        if (slot < m_size) {
+            stratum.reservoir[slot] = row;
+        }
+    }
+    m_rows += count;
+}
+
+void StratifiedSample::reset() {
+    m_rows = 0;
+    m_bounds.clear();
+    m_strata.clear();
+    m_random.seed(42);
+}
+
+std::vector<int> StratifiedSample::order(const size_t& rows) const {
+    /**
+     * Proportional allocation with a floor of a quarter of an even split. 
+     * Rows of all strata are interleaved by their relative position, so 
+     * every prefix of the sample is stratified as well.
+    **/
+
+    std::vector<std::pair<double, int>> sample;
+    size_t floor = m_strata.empty() ? 0 : m_size / (4 * m_strata.size());
+    auto random = m_random;
+    for (const auto& stratum : m_strata) {
+        size_t share = std::max<size_t>(floor, m_size * stratum.seen / std::max<size_t>(m_rows, 1));
+        size_t count = std::min(share, stratum.reservoir.size());
+        
+        // random subset of a uniform reservoir is uniform too, first entries are in arrival order
+        auto rows = stratum.reservoir;
+        std::shuffle(rows.begin(), rows.end(), random);
+        for (size_t i = 0; i < count; i++) {
+            sample.push_back({(i + 0.5) / count, rows[i]});
+        }
+    }
+    std::sort(sample.begin(), sample.end());
+
+    std::vector<int> order;
+    order.reserve(rows);
+    std::vector<bool> sampled(rows, false);
+    for (const auto& entry : sample) {
+        if (entry.second < rows) {
+            order.push_back(entry.second);
+            sampled[entry.second] = true;
+        }
+    }
+    for (size_t row = 0; row < rows; row++) {
+        if (!sampled[row]) {
+            order.push_back(row);
+        }
+    }
+    return order;
+}
+
+size_t StratifiedSample::size() const {
+    size_t size = 0;
+    size_t floor = m_strata.empty() ? 0 : m_size / (4 * m_strata.size());
+    for (const auto& stratum : m_strata) {
+        size_t share = std::max<size_t>(floor, m_size * stratum.seen / std::max<size_t>(m_rows, 1));
+        size += std::min(share, stratum.reservoir.size());
+    }
+    return size;
+}
+
+void StratifiedSample::report() const {
+    spdlog::info("Preview sample: {} of {} rows, {} {} of attribute {}", 
+        size(), m_rows, m_strata.size(), m_categorical ? "classes" : "quantiles", m_attribute);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <random>
+#include <vector>
+
+/**
+ * Stratified reservoir sample of the rows, updated while rows stream in.
+ * Strata are the classes of a categorical attribute (few distinct values) 
+ * or value quantiles of a numeric one, both fixed by the first rows. Every 
+ * stratum gets at least a minimum share, so rare classes show up early.
+**/
+class StratifiedSample {
+public:
+    StratifiedSample();
+    StratifiedSample(const int& attributes, const int& attribute, const size_t& size);
+    void append(const float* rows, const size_t& count);
+    void reset(); // forget all rows, strata are rebuilt from the next ones
+    std::vector<int> order(const size_t& rows) const; // sampled rows first, then the rest in row order
+    size_t size() const;
+    void report() const;
+
+private:
+    static const int MAX_CLASSES = 16;
+    static const int QUANTILES = 8;
+
+    struct Stratum {
+        std::vector<int> reservoir; // uniform sample of the rows seen
+        size_t seen;
+    };
+
+    void initializeStrata(const float* rows, const size_t& count);
+    int stratum(const float& value) const;
+
+    int m_num_attributes;
+    int m_attribute; // stratified by this attribute
+    size_t m_size;
+    size_t m_rows;
+    bool m_categorical;
+    std::vector<float> m_bounds; // class values or upper quantile bounds, sorted
+    std::vector<Stratum> m_strata;
+    std::mt19937 m_random;
+};
@@ -6,6 +6,8 @@
 #include <glm/glm.hpp>
 #include <glad/glad.h>
 #include <variant>
+#include <memory>
+#include <unordered_set>
 #include <expansionMiddle.hpp>
 #include <expansionActive.hpp>
 
@@ -56,6 +58,80 @@ struct AxisVertex {
     float colorIndx;
 };
 
+struct Settings {
+    bool quantize = false; // store data on gpu as 8/16 bit per value instead of float
+    int timeSteps = 4; // time steps per line
+    int visibleTimeSteps = 0; // time steps drawn per expansion, 0 -> all
+    float frameBudgetMs = 6.0f; // gpu time per frame for progressive base layer rendering
+    std::string shaderCacheDir = "shader_cache"; // program binaries, keyed by driver and source hash
+    float gpuBudgetMb = 0.0f; // warn when gpu resources exceed it, 0 -> no budget
+    bool checkAllocations = false; // warn about heap allocations during steady interaction
+    int visibleAxes = 0; // axis laid out across the window, others are scrolled to, 0 -> all
+    bool filter = false; // start in filter mode, unselected lines hidden
+    std::string dataPath = "../iris.txt"; // csv, '.cols' or '.manifest', see Dataset
+    std::string convertPath = ""; // write the projected columns as '.cols' file and exit
+    float residentMb = 0.0f; // gpu budget for paged data rows, line colors and indices of a columnar file, 0 -> everything resident
+    int previewRows = 8192; // stratified sample drawn before the other rows, 0 -> file order
+    int strataAttribute = -1; // attribute the sample is stratified by, -1 -> last
+    bool benchScheduler = false; // run the scheduler micro benchmarks instead of the app
+    bool headless = false; // hidden window of fixed size instead of fullscreen
+    std::string recordPath = ""; // log input events to this file
+    std::string replayPath = ""; // feed the events of a recording instead of live input, exit once done
+    std::string benchmarkPath = ""; // time core routines against this baseline file and exit, 1 on regression
+    bool updateBaseline = false; // store the benchmark results as new baseline
+    bool allocationTest = false; // brush a synthetic dataset headless and exit, 1 if a warm frame allocates
+};
+
+struct DrawRange {
+    size_t first; // first index
+    size_t count; // number of indicies
+};
+
+struct QuantizedAttribute {
+    glm::vec2 dequant;      // scale, bias -> fma(q, scale, bias) lands in target range
+    unsigned int bitOffset; // offset within packed row
+    unsigned int bits;      // 8 or 16
+};
+
+struct QuantizedData {
+    std::vector<unsigned int> words;
+    std::vector<QuantizedAttribute> attributes;
+    int rowWords;
+    std::vector<std::unordered_set<float>> distinct; // values of 8 bit attributes, more than 256 need 16 bit
+};
+
+struct PyramidBucket {
+    // std430 layout of Bucket in timeseries.vert
+    glm::vec4 values; // first, min & max in temporal order, last
+    glm::vec4 times; // time step every value was sampled at
+};
+
+struct PyramidLevel {
+    int offset; // first bucket of level in pyramid buffer
+    int buckets; // buckets per line and attribute
+    int bucketSize; // time steps per bucket
+};
+
+struct TimeSeriesSide {
+    // std430 layout of SideParameters in timeseries.vert
+    glm::mat4 transform;
+    int attributeIdx;
+    int pyramidLevel; // 0 -> raw samples
+    int pyramidOffset;
+    int pyramidBuckets;
+    int bucketSize;
+    int bucketFirst;
+    int bucketCount;
+    int vertexCount;
+};
+
+struct DrawArraysIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint first;
+    GLuint baseInstance; // used as draw id
+};
+
 struct SortObj {
     float val;
     int index;
@@ -73,6 +149,6 @@ struct TimeExpansion {
     glm::mat4 model_right;
     glm::mat4 view;
     
-    ExpansionMiddle* middle; // middle section for this entry
-    ExpansionActive* addVisualizer; // highlighter when adding axis to expansion
+    std::unique_ptr<ExpansionMiddle> middle; // middle section for this entry
+    std::unique_ptr<ExpansionActive> addVisualizer; // highlighter when adding axis to expansion
 };
@@ -7,24 +7,28 @@ bool operator==(const TimeExpansion& a, const TimeExpansion& b) {
   return false;
 }
 
-TimeSeries::TimeSeries(GraphApp* app):
+TimeSeries::TimeSeries(GraphApp* app, const int& visibleTimeSteps):
 	Tool(app), 
-    m_num_timeAxis{*app->getNumTimeAxis()}
+    m_num_timeAxis{*app->getNumTimeAxis()},
+    m_time_first{0},
+    m_time_count{*app->getNumTimeAxis()},
+    m_pyramid_series{0}
  {
-    auto vert_shader = gl::load_shader_from_file("shaders/timeseries.vert", GL_VERTEX_SHADER);
-    auto tcs_shader = gl::load_shader_from_file("shaders/timeseries.tesc", GL_TESS_CONTROL_SHADER);
-    auto tes_shader = gl::load_shader_from_file("shaders/timeseries.tese", GL_TESS_EVALUATION_SHADER);
-    auto frag_shader = gl::load_shader_from_file("shaders/polyline.frag", GL_FRAGMENT_SHADER);
-    m_program = gl::create_program({vert_shader, tcs_shader, tes_shader, frag_shader});
-    
-    vert_shader = gl::load_shader_from_file("shaders/timeseriesmiddle.vert", GL_VERTEX_SHADER);
-    tcs_shader = gl::load_shader_from_file("shaders/polyline.tesc", GL_TESS_CONTROL_SHADER);
-    tes_shader = gl::load_shader_from_file("shaders/polyline.tese", GL_TESS_EVALUATION_SHADER);
-    m_middle_program = gl::create_program({vert_shader, tcs_shader, tes_shader, frag_shader});
-    
-    vert_shader = gl::load_shader_from_file("shaders/expansion_active.vert", GL_VERTEX_SHADER);
-    frag_shader = gl::load_shader_from_file("shaders/axis.frag", GL_FRAGMENT_SHADER);
-    m_addVisualizer_program = gl::create_program({vert_shader, frag_shader});
+    // shared stages are only compiled once by the library
+    auto library = m_linkedApp->getProgramLibrary();
+    m_program = library->program({
+        "shaders/timeseries.vert", 
+        "shaders/timeseries.tesc", 
+        "shaders/timeseries.tese", 
+        "shaders/polyline.frag"
+    });
+    m_middle_program = library->program({
+        "shaders/timeseriesmiddle.vert", 
+        "shaders/polyline.tesc", 
+        "shaders/polyline.tese", 
+        "shaders/polyline.frag"
+    });
+    m_addVisualizer_program = library->program({"shaders/expansion_active.vert", "shaders/axis.frag"});
 
     
     // model relative to screen space
@@ -41,39 +45,17 @@ TimeSeries::TimeSeries(GraphApp* app):
     m_projection = glm::mat4(1.0f);
     //m_projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 1000.0f);
 
-    // init index vertex stuff
+    // geometry is generated in the vertex shader, only the visible window is drawn
     initializeVertexBuffers();
-    initializeIndexBuffers();
-    initializeStorageBuffers();
+    updatePyramid();
+    if (visibleTimeSteps > 0) {
+        setTimeWindow(0, visibleTimeSteps);
+    }
     
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_ALWAYS);
 }
 
-TimeSeries::~TimeSeries() {
-    if (glIsBuffer(m_vbo)) {
-        glDeleteBuffers(1, &m_vbo);
-    }
-    if (glIsVertexArray(m_vao)) {
-        glDeleteVertexArrays(1, &m_vao);
-    }
-    if (glIsBuffer(m_ibo)) {
-        glDeleteBuffers(1, &m_ibo);
-    }
-    if (glIsBuffer(m_time_ssbo)) {
-        glDeleteBuffers(1, &m_time_ssbo);
-    }
-    if (glIsProgram(m_program)) {
-        glDeleteProgram(m_program);
-    }
-    if (glIsProgram(m_middle_program)) {
-        glDeleteProgram(m_middle_program);
-    } 
-    if (glIsProgram(m_addVisualizer_program)) {
-        glDeleteProgram(m_addVisualizer_program);
-    }
-}
-
 bool TimeSeries::checkSelection(const glm::vec2& cursor) {
     // convert mouse position to   
     float x = Utils::remap(cursor.x, glm::vec2(0, m_linkedApp->resolution().x), glm::vec2(-1, 1));
@@ -81,8 +63,8 @@ bool TimeSeries::checkSelection(const glm::vec2& cursor) {
     auto ss_pos = m_mouse_model * glm::vec4(glm::vec2(x, y), 0, 1);    
 
     // check if mouse is between axis and report these
-    auto axis = *m_linkedApp->getAxis();
-    auto order = *m_linkedApp->getAxisOrder();
+    const auto& axis = *m_linkedApp->getAxis();
+    const auto& order = *m_linkedApp->getAxisOrder();
     for (int i = 0; i < order.size() - 1; i++) {
 
         auto aabb = AABB{
@@ -151,16 +133,16 @@ void TimeSeries::createEntry(TimeExpansion& entry) const{
     // entry.angle = 10.0f;
     
     // create middle section
-    entry.middle = new ExpansionMiddle(
+    entry.middle = std::make_unique<ExpansionMiddle>(
         entry.leftAxisIndex, 
         entry.rightAxisIndex, 
-        m_linkedApp->getData()->size() / m_linkedApp->getAxis()->size() / m_num_timeAxis,
+        m_linkedApp->getColumns()->rows(),
         m_linkedApp->getAxis()->size(),
         m_middle_program,
         m_linkedApp
     );
 
-    entry.addVisualizer = new ExpansionActive(
+    entry.addVisualizer = std::make_unique<ExpansionActive>(
         entry.leftAxisIndex, 
         entry.rightAxisIndex,
         m_addVisualizer_program,
@@ -169,15 +151,17 @@ void TimeSeries::createEntry(TimeExpansion& entry) const{
 
     // add entry as as expansion
     TimeSeries* ptr = const_cast<TimeSeries*>(this);
-    ptr->m_expansions.push_back(entry);
+    ptr->m_expansions.push_back(std::move(entry));
     
-    // update all entrys
-    updateEntries();
+    // pick up axis already placed between left and right
+    const auto& axis = *m_linkedApp->getAxis();
+    for (int idx = 0; idx < axis.size(); idx++) {
+        ptr->updateMiddle(ptr->m_expansions.back(), idx, axis);
+    }
 }
 
 void TimeSeries::setEntryCoords(TimeExpansion& entry) const {
-    auto axis = *m_linkedApp->getAxis();
-    auto order = *m_linkedApp->getAxisOrder();
+    const auto& axis = *m_linkedApp->getAxis();
     
     // dynamic rotation dependent on axis distance
     entry.angle = glm::clamp(45 * glm::distance(axis[entry.leftAxisIndex], axis[entry.rightAxisIndex]) / (2 * m_mouse_model[2][2]), 0.0f, 45.0f);
@@ -200,57 +184,74 @@ void TimeSeries::setEntryCoords(TimeExpansion& entry) const {
                            glm::vec3(0.0f, 1.0f, 0.0f));
 }
 
-void TimeSeries::updateEntries() const {
-    auto axis = *m_linkedApp->getAxis();
-    
-    // check if axis were shifted, if not -> return
-    if (axis == m_prevAxis) {
-        return;
-    }
+static bool contains(const std::vector<int>& values, const int& value) {
+    return std::find(values.begin(), values.end(), value) != values.end();
+}
 
-    auto order = m_linkedApp->getAxisOrder();
-    TimeSeries* ptr = const_cast<TimeSeries*>(this);
-    for (auto& entry : ptr->m_expansions) {
+void TimeSeries::updateMembership() {
+    const auto& axis = *m_linkedApp->getAxis();
+    const auto& moved = *m_linkedApp->getMovedAxis();
+    
+    bool changed = false;
+    for (auto& entry : m_expansions) {
+        if (!contains(moved, entry.leftAxisIndex) && !contains(moved, entry.rightAxisIndex)) {
+            // bounds stayed, only moved axis can enter or leave the middle
+            for (const auto& idx : moved) {
+                changed |= updateMiddle(entry, idx, axis);
+            }
+            continue;
+        }
         
         // check if axis got flipped
         if (axis[entry.leftAxisIndex] > axis[entry.rightAxisIndex]) {
-            auto tmp = entry.leftAxisIndex;
-            entry.leftAxisIndex = entry.rightAxisIndex;
-            entry.rightAxisIndex = tmp;
-        }       
-
-        // check if any axis is between left and right -> if so, add them to middle
-        for (const auto& idx : *order) {
-            auto it = std::find(entry.middleAxisIndicies.begin(), entry.middleAxisIndicies.end(), idx);
-            if (it == entry.middleAxisIndicies.end() && // check if not in middle
-                axis[idx] > axis[entry.leftAxisIndex] &&  // and inbetween axis
-                axis[idx] < axis[entry.rightAxisIndex]) {
-                
-                // add to middle
-                entry.middleAxisIndicies.push_back(idx);
-                entry.addVisualizer->setActive(true);
-                // entry.middle->updateAxis(entry.middleAxisIndicies);
-                ptr->updateParentIndicies();
-            } 
-            else if (it != entry.middleAxisIndicies.end() && // if already in middle
-                     (axis[idx] < axis[entry.leftAxisIndex] ||  // and nolong inbetween axis
-                      axis[idx] > axis[entry.rightAxisIndex])) {
-                
-                // remove from middle
-                entry.middleAxisIndicies.erase(it);
-                entry.addVisualizer->setActive(false);
-                // remove entry when draged outside immidiately
-                entry.middle->updateAxis(entry.middleAxisIndicies);
-                ptr->updateParentIndicies();
-            }
+            std::swap(entry.leftAxisIndex, entry.rightAxisIndex);
+        }
+
+        // bounds moved, any axis can be between left and right now
+        for (int idx = 0; idx < axis.size(); idx++) {
+            changed |= updateMiddle(entry, idx, axis);
         }
+    }
+    
+    if (changed) {
+        updateParentIndicies();
+    }
+}
+
+bool TimeSeries::updateMiddle(TimeExpansion& entry, const int& idx, const std::vector<float>& axis) {
+    auto it = std::find(entry.middleAxisIndicies.begin(), entry.middleAxisIndicies.end(), idx);
+    if (it == entry.middleAxisIndicies.end() && // check if not in middle
+        axis[idx] > axis[entry.leftAxisIndex] &&  // and inbetween axis
+        axis[idx] < axis[entry.rightAxisIndex]) {
+        
+        // add to middle
+        entry.middleAxisIndicies.push_back(idx);
+        entry.addVisualizer->setActive(true);
+        // entry.middle->updateAxis(entry.middleAxisIndicies);
+        return true;
+    } 
+    else if (it != entry.middleAxisIndicies.end() && // if already in middle
+             (axis[idx] < axis[entry.leftAxisIndex] ||  // and nolong inbetween axis
+              axis[idx] > axis[entry.rightAxisIndex])) {
         
-        // setup all mats and coords
-        setEntryCoords(entry);
+        // remove from middle
+        entry.middleAxisIndicies.erase(it);
+        entry.addVisualizer->setActive(false);
+        // remove entry when draged outside immidiately
+        entry.middle->updateAxis(entry.middleAxisIndicies);
+        return true;
     }
+    return false;
+}
 
-    // update axis
-    ptr->m_prevAxis = axis;
+void TimeSeries::updateTransforms() {
+    // mats only depend on left and right axis position
+    const auto& moved = *m_linkedApp->getMovedAxis();
+    for (auto& entry : m_expansions) {
+        if (contains(moved, entry.leftAxisIndex) || contains(moved, entry.rightAxisIndex)) {
+            setEntryCoords(entry);
+        }
+    }
 }
 
 void TimeSeries::updateParentIndicies() {
@@ -272,41 +273,53 @@ void TimeSeries::updateParentIndicies() {
 
 bool TimeSeries::draw() const {
     // if there is nothing to draw -> retrun
-    if (m_expansions.empty()) {
+    if (m_expansions.empty() || m_time_count < 2) {
         return true;
     }
     
-    // update all entrys according to their respectiv axis
-    updateEntries();
-   
     // now here render that stuff
     glUseProgram(m_program);
     glDepthMask(GL_TRUE);
     
     gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "projection"), glm::mat4(1.0f));
     gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "to_range"), glm::vec2(-1, 1));
-    glProgramUniform1i(m_program, glGetUniformLocation(m_program, "num_data"), m_linkedApp->getData()->size() / m_num_timeAxis);
+    glProgramUniform1i(m_program, glGetUniformLocation(m_program, "num_data"), m_linkedApp->getColumns()->rows() * m_linkedApp->getAxis()->size());
     glProgramUniform1i(m_program, glGetUniformLocation(m_program, "num_attrib"), m_linkedApp->getAxis()->size());
     glProgramUniform1i(m_program, glGetUniformLocation(m_program, "num_times"), m_num_timeAxis);
+    glProgramUniform1i(m_program, glGetUniformLocation(m_program, "time_first"), m_time_first);
+    glProgramUniform1i(m_program, glGetUniformLocation(m_program, "time_count"), m_time_count);
+    m_linkedApp->setDataFormatUniforms(m_program);
     
-    glBindVertexArray(m_vao);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, m_time_ssbo);
-    glPatchParameteri(GL_PATCH_VERTICES, 2);
+    auto line_count = m_linkedApp->getColumns()->rows();
+
+    gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "view"), glm::mat4(1.0f));
     
+    // parameters of left & right side of every expansion, each at the resolution of its own panel
+    auto sides = m_side_ssbo->map_next<TimeSeriesSide>();
+    auto commands = m_indirect_buffer->map_next<DrawArraysIndirectCommand>();
+    int side_count = 0;
     for (const auto& item : m_expansions) {
-        gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "view"), glm::mat4(1.0f));
-        
-        // draw left 
-        glProgramUniform1i(m_program, glGetUniformLocation(m_program, "attribute_idx"), item.leftAxisIndex);
-        gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "transform"), item.model_left);
-        glDrawElements(GL_PATCHES, m_indicies.size(), GL_UNSIGNED_SHORT, (const void*)0);
-        
-        // draw right
-        glProgramUniform1i(m_program, glGetUniformLocation(m_program, "attribute_idx"), item.rightAxisIndex);
-        gl::set_program_uniform(m_program, glGetUniformLocation(m_program, "transform"), item.model_right);        
-        glDrawElements(GL_PATCHES, m_indicies.size(), GL_UNSIGNED_SHORT, (const void*)0);
+        if (side_count + 2 > m_max_sides) {
+            break;
+        }
+        sides[side_count] = createSide(item.leftAxisIndex, item.model_left, line_count);
+        sides[side_count + 1] = createSide(item.rightAxisIndex, item.model_right, line_count);
+        for (int i = side_count; i < side_count + 2; i++) {
+            commands[i] = DrawArraysIndirectCommand{GLuint(sides[i].vertexCount), 1, 0, GLuint(i)};
+        }
+        side_count += 2;
     }
+    gl::CallCounter::add_uploaded(side_count * (sizeof(TimeSeriesSide) + sizeof(DrawArraysIndirectCommand)));
+
+    glBindVertexArray(m_vao.id());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, m_pyramid_ssbo.id());
+    m_side_ssbo->bind_range(GL_SHADER_STORAGE_BUFFER, 7);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirect_buffer->id());
+    glPatchParameteri(GL_PATCH_VERTICES, 2);
+    
+    // all expansions in one call
+    glMultiDrawArraysIndirect(GL_PATCHES, (const void*)m_indirect_buffer->offset(), side_count, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
       
     glDepthMask(GL_FALSE);
 
@@ -320,69 +333,213 @@ bool TimeSeries::draw() const {
 }
 
 bool TimeSeries::registerTool() {
+    // expansions follow axis moves, membership changes feed back into the excluded axis
+    auto graph = m_linkedApp->getGraph();
+    m_membership_node = graph->addNode("expansion membership", [this]() { updateMembership(); });
+    graph->addDependency(m_membership_node, m_linkedApp->getAxisNode());
+    // excluded axis only change if membership did (updateExcludedAxis marks them),
+    // but have to be handled after it in the same pass
+    graph->addOrdering(m_linkedApp->getExclusionNode(), m_membership_node);
+    
+    m_transform_node = graph->addNode("expansion transforms", [this]() { updateTransforms(); });
+    graph->addDependency(m_transform_node, m_membership_node);
+    
+    // rows streamed in by the loader extend every series and every middle section
+    auto pyramid_node = graph->addNode("time pyramid", [this]() {
+        updatePyramid();
+        int lines = m_linkedApp->getColumns()->rows();
+        for (const auto& entry : m_expansions) {
+            entry.middle->setLineCount(lines);
+        }
+    });
+    graph->addDependency(pyramid_node, m_linkedApp->getRowsNode());
 	return true;
 }
 
 void TimeSeries::initializeVertexBuffers() {
-	// setup vertex array object and vertex buffer
-    glCreateVertexArrays(1, &m_vao);
-    glCreateBuffers(1, &m_vbo);
-    glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, sizeof(Vertex));
+	// vertices are generated from gl_VertexID, the only attribute is the draw id
+    m_vao = gl::VertexArray{"TimeSeries"};
+    
+    // an expansion lies between two neighbouring axis, so there are at most two sides per axis
+    m_max_sides = m_linkedApp->getAxis()->size() * 2;
+    std::vector<GLint> draw_ids(m_max_sides);
+    std::iota(draw_ids.begin(), draw_ids.end(), 0);
+    
+    // instanced attribute, instances are offset by the base instance of each indirect command
+    m_draw_id_vbo = gl::Buffer("TimeSeries", Utils::vectorsizeof(draw_ids), draw_ids.data());
+    glVertexArrayVertexBuffer(m_vao.id(), 0, m_draw_id_vbo.id(), 0, sizeof(GLint));
+    glVertexArrayBindingDivisor(m_vao.id(), 0, 1);
+    glEnableVertexArrayAttrib(m_vao.id(), 0);
+    glVertexArrayAttribIFormat(m_vao.id(), 0, 1, GL_INT, 0);
+    glVertexArrayAttribBinding(m_vao.id(), 0, 0);
+
+    m_side_ssbo = std::make_unique<gl::StreamBuffer>("TimeSeries", m_max_sides * sizeof(TimeSeriesSide));
+    m_indirect_buffer = std::make_unique<gl::StreamBuffer>("TimeSeries", m_max_sides * sizeof(DrawArraysIndirectCommand));
+}
+
+std::vector<std::vector<PyramidBucket>> TimeSeries::buildPyramid(const int& first, const int& count) const {
+    // M4 pyramid, every bucket keeps first, min, max and last sample of its 
+    // time steps so a downsampled line covers the same pixels as the full one
+    struct Bucket {
+        float first, last, min, max;
+        int first_time, last_time, min_time, max_time;
+    };
+
+    const auto& columns = *m_linkedApp->getColumns();
+    int num_attrib = m_linkedApp->getAxis()->size(); // one series per line and attribute
+    
+    // raw samples are buckets of size one, time steps repeat the rows of the first one
+    std::vector<Bucket> prev(count * m_num_timeAxis);
+    for (int s = 0; s < count; s++) {
+        float value = columns.value((first + s) % num_attrib, (first + s) / num_attrib);
+        for (int t = 0; t < m_num_timeAxis; t++) {
+            prev[s * m_num_timeAxis + t] = Bucket{value, value, value, value, t, t, t, t};
+        }
+    }
+    
+    // each level merges pairs of buckets of the previous one, an odd tail bucket 
+    // is carried over as is and keeps the time steps it actually covers
+    std::vector<std::vector<PyramidBucket>> pyramid;
+    int prev_buckets = m_num_timeAxis;
+    while (prev_buckets > 1) {
+        int buckets = (prev_buckets + 1) / 2;
+        std::vector<Bucket> level(count * buckets);
+        
+        pyramid.emplace_back(count * buckets);
+        for (int s = 0; s < count; s++) {
+            for (int b = 0; b < buckets; b++) {
+                auto bucket = prev[s * prev_buckets + 2 * b];
+                if (2 * b + 1 < prev_buckets) {
+                    const auto& next = prev[s * prev_buckets + 2 * b + 1];
+                    bucket.last = next.last;
+                    bucket.last_time = next.last_time;
+                    if (next.min < bucket.min) {
+                        bucket.min = next.min;
+                        bucket.min_time = next.min_time;
+                    }
+                    if (next.max > bucket.max) {
+                        bucket.max = next.max;
+                        bucket.max_time = next.max_time;
+                    }
+                }
+                level[s * buckets + b] = bucket;
+
+                // min & max are stored in temporal order, each with the time step it was sampled at
+                auto& item = pyramid.back()[s * buckets + b];
+                if (bucket.min_time <= bucket.max_time) {
+                    item.values = glm::vec4(bucket.first, bucket.min, bucket.max, bucket.last);
+                    item.times = glm::vec4(bucket.first_time, bucket.min_time, bucket.max_time, bucket.last_time);
+                } 
+                else {
+                    item.values = glm::vec4(bucket.first, bucket.max, bucket.min, bucket.last);
+                    item.times = glm::vec4(bucket.first_time, bucket.max_time, bucket.min_time, bucket.last_time);
+                }
+            }
+        }
+        
+        prev.swap(level);
+        prev_buckets = buckets;
+    }
+    
+    return pyramid;
+}
+
+void TimeSeries::invalidatePyramid() {
+    m_pyramid_series = 0;
+}
+
+void TimeSeries::updatePyramid() {
+    // rows are only ever appended, so the buckets of series already in the pyramid stay 
+    // valid. Only the new series are built, the old ones are copied on the gpu
+    int series_count = m_linkedApp->getColumns()->rows() * m_linkedApp->getAxis()->size();
+    int old_series = m_pyramid_series;
+    if (old_series > 0 && series_count == old_series) {
+        return;
+    }
+    auto pyramid = buildPyramid(old_series, series_count - old_series);
     
-    // setup value id attribute
-    GLuint id_attrib_idx = 0;
-    glEnableVertexArrayAttrib(m_vao, id_attrib_idx);
-    glVertexArrayAttribFormat(m_vao, id_attrib_idx, 1, GL_FLOAT, false, offsetof(Vertex, id));
-    glVertexArrayAttribBinding(m_vao, id_attrib_idx, 0);
-
-    // setup attribute index id attribute
-    GLuint att_attrib_idx = 1;
-    glEnableVertexArrayAttrib(m_vao, att_attrib_idx);
-    glVertexArrayAttribFormat(m_vao, att_attrib_idx, 1, GL_FLOAT, false, offsetof(Vertex, attIndx));
-    glVertexArrayAttribBinding(m_vao, att_attrib_idx, 0);
+    // levels are stored one after another, every level holds all series
+    auto old_levels = m_levels;
+    m_levels.clear();
+    int offset = 0;
+    for (int i = 0, size = 2; i < pyramid.size(); i++, size *= 2) {
+        int buckets = (m_num_timeAxis + size - 1) / size;
+        m_levels.push_back(PyramidLevel{offset, buckets, size});
+        offset += series_count * buckets;
+    }
     
-    // vertecie are the same for all time z-axis time esxpansions
-    auto line_count = m_linkedApp->getData()->size() / m_linkedApp->getAxis()->size();
-    for (int i = 0; i < line_count; i++) {
-        m_vertices.push_back(Vertex{
-            float(i / m_num_timeAxis),  // id
-            float(i % m_num_timeAxis)   // time 
-        });
+    gl::Buffer pyramid_ssbo("TimeSeries", std::max(offset, 1) * sizeof(PyramidBucket), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    for (int i = 0; i < m_levels.size(); i++) {
+        const auto& level = m_levels[i];
+        if (old_series > 0) {
+            glCopyNamedBufferSubData(m_pyramid_ssbo.id(), pyramid_ssbo.id(), old_levels[i].offset * sizeof(PyramidBucket), 
+                level.offset * sizeof(PyramidBucket), old_series * level.buckets * sizeof(PyramidBucket));
+        }
+        glNamedBufferSubData(pyramid_ssbo.id(), (level.offset + old_series * level.buckets) * sizeof(PyramidBucket), 
+            Utils::vectorsizeof(pyramid[i]), pyramid[i].data());
     }
-    glNamedBufferData(m_vbo, Utils::vectorsizeof(m_vertices), m_vertices.data(), GL_DYNAMIC_DRAW);
+    m_pyramid_ssbo = std::move(pyramid_ssbo);
+    m_pyramid_series = series_count;
+    spdlog::debug("time pyramid: {} levels, {} new series, {} kb", m_levels.size(), series_count - old_series, offset * sizeof(PyramidBucket) / 1024);
 }
 
-void TimeSeries::initializeIndexBuffers() {
-    // indicies are the same for all time z-axis time esxpansions    
-    auto line_count = m_linkedApp->getData()->size() / m_linkedApp->getAxis()->size();
-    for (unsigned short i = 0; i < line_count; i++) {
-        m_indicies.push_back(i);
-        if (i % m_num_timeAxis != 0 && i % m_num_timeAxis != m_num_timeAxis - 1) {
-            m_indicies.push_back(i);
+int TimeSeries::selectLevel(const glm::mat4& model) const {
+    // width of the panel in pixels, the time axis spans x from 0 to 1
+    auto start = m_projection * model * glm::vec4(0, 0, 0, 1);
+    auto end = m_projection * model * glm::vec4(1, 0, 0, 1);
+    auto ndc = glm::vec2(end) / end.w - glm::vec2(start) / start.w;
+    float pixels = glm::length(ndc * glm::vec2(m_linkedApp->resolution()) * 0.5f);
+    
+    // raw samples if every time step gets at least a pixel
+    if (m_time_count <= pixels) {
+        return -1;
+    }
+    
+    // coarsest level needed so that there is about one bucket per pixel
+    for (int i = 0; i < m_levels.size(); i++) {
+        int size = m_levels[i].bucketSize;
+        int visible = (m_time_first + m_time_count - 1) / size - m_time_first / size + 1;
+        if (visible <= pixels) {
+            return i;
         }
     }
 
-    glGenBuffers(1, &m_ibo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, Utils::vectorsizeof(m_indicies), m_indicies.data(), GL_DYNAMIC_DRAW);
+    return m_levels.size() - 1;
 }
 
-void TimeSeries::initializeStorageBuffers() {
-    for (int i = 0; i < m_num_timeAxis; i++) {
-        //auto val = Utils::remap((float)i / (m_num_timeAxis - 1), glm::vec2{0, 1}, glm::vec2{-1, 1});
-        auto val = (float)i / (m_num_timeAxis - 1);
-        m_timeAxis.push_back(val);
+TimeSeriesSide TimeSeries::createSide(const int& attribute, const glm::mat4& model, const int& line_count) const {
+    auto side = TimeSeriesSide{model, attribute};
+    
+    auto level = selectLevel(model);
+    if (level < 0) {
+        // two vertices per visible time segment and line
+        side.pyramidLevel = 0;
+        side.vertexCount = line_count * (m_time_count - 1) * 2;
+        return side;
     }
-   
-    GLuint time_pos_binding = 4;
-    glCreateBuffers(1, &m_time_ssbo);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, time_pos_binding, m_time_ssbo);
-    glNamedBufferData(m_time_ssbo, Utils::vectorsizeof(m_timeAxis), m_timeAxis.data(), GL_DYNAMIC_DRAW);
+
+    // four points per visible bucket, bounded by the panel width
+    const auto& item = m_levels[level];
+    side.pyramidLevel = level + 1;
+    side.pyramidOffset = item.offset;
+    side.pyramidBuckets = item.buckets;
+    side.bucketSize = item.bucketSize;
+    side.bucketFirst = m_time_first / item.bucketSize;
+    side.bucketCount = (m_time_first + m_time_count - 1) / item.bucketSize - side.bucketFirst + 1;
+    side.vertexCount = line_count * (side.bucketCount * 4 - 1) * 2;
+    return side;
+}
+
+void TimeSeries::setTimeWindow(const int& first, const int& count) {
+    m_time_count = glm::clamp(count, 1, m_num_timeAxis);
+    m_time_first = glm::clamp(first, 0, m_num_timeAxis - m_time_count);
+}
+
+void TimeSeries::scrollTimeWindow(const int& steps) {
+    setTimeWindow(m_time_first + steps, m_time_count);
 }
 
 void TimeSeries::deleteEntry(const int& index) {
-    auto entry = m_expansions[index];
-    delete entry.middle;
-    delete entry.addVisualizer;
+    // middle & visualizer free their gpu resources with the entry
     m_expansions.erase(m_expansions.begin() + index);
 }
\ No newline at end of file
@@ -4,32 +4,43 @@
 #include <spdlog/spdlog.h>
 #include <gl/program.hpp>
 #include <gl/shader.hpp>
+#include <gl/stream_buffer.hpp>
+#include <gl/resource.hpp>
 
 #include <tool.hpp>
 #include <structs.hpp>
 #include <utils.hpp>
+#include <dependencyGraph.hpp>
 #include <graphApp.hpp>
 #include <expansionMiddle.hpp>
 #include <list>
 #include <functional>
+#include <memory>
+#include <numeric>
 
 class TimeSeries : Tool {
 public:
-    TimeSeries(GraphApp* app);
-	~TimeSeries();
+    TimeSeries(GraphApp* app, const int& visibleTimeSteps = 0);
     bool draw() const override;
     bool registerTool() override;
     bool checkSelection(const glm::vec2& cursor);
     void updateSelections();
+    void setTimeWindow(const int& first, const int& count);
+    void scrollTimeWindow(const int& steps);
+    void invalidatePyramid(); // values changed in place, every series is rebuilt with the next rows update
     
 private:
     void createEntry(TimeExpansion& entry) const;
     void setEntryCoords(TimeExpansion& entry) const;
     void updateParentIndicies();
     void initializeVertexBuffers();
-    void initializeIndexBuffers();
-    void initializeStorageBuffers();
-    void updateEntries() const;
+    void updatePyramid();
+    std::vector<std::vector<PyramidBucket>> buildPyramid(const int& first, const int& count) const;
+    int selectLevel(const glm::mat4& model) const;
+    TimeSeriesSide createSide(const int& attribute, const glm::mat4& model, const int& line_count) const;
+    void updateMembership();
+    void updateTransforms();
+    bool updateMiddle(TimeExpansion& entry, const int& idx, const std::vector<float>& axis);
     void deleteEntry(const int& index);
         
     GLuint m_program;
@@ -39,17 +50,21 @@ private:
     glm::mat4 m_mouse_model; // scale of screen to polyine
     glm::mat4 m_view;
     glm::mat4 m_projection;
-    GLuint m_vao;
-    GLuint m_vbo;
-    GLuint m_ibo;
-    GLuint m_time_ssbo;
+    gl::VertexArray m_vao;
+    gl::Buffer m_pyramid_ssbo;
+    gl::Buffer m_draw_id_vbo;
+    int m_max_sides;
+    std::unique_ptr<gl::StreamBuffer> m_side_ssbo;
+    std::unique_ptr<gl::StreamBuffer> m_indirect_buffer; // one command per expansion side
+    std::vector<PyramidLevel> m_levels; // level i holds buckets of 2^(i+1) time steps
+    int m_pyramid_series; // series in the pyramid, appended rows only add new ones
 
     int m_num_timeAxis;
-    std::vector<Vertex> m_vertices;
-    std::vector<unsigned short> m_indicies;
+    int m_time_first; // visible time window, geometry is only generated for it
+    int m_time_count;
     std::vector<TimeExpansion> m_expansions;
-    std::vector<float> m_prevAxis;
-    std::vector<float> m_timeAxis;
+    DependencyGraph::Node m_membership_node; // middle axis & flips, recomputed on axis moves
+    DependencyGraph::Node m_transform_node;
     std::vector<int> m_excludedAxis; // left & right
     std::vector<int> m_middleAxis;  // middle
 };
\ No newline at end of file
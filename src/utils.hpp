@@ -6,7 +6,11 @@
 #include <string>
 #include <chrono>
 #include <algorithm>
+#include <cmath>
+#include <unordered_set>
+#include <functional>
 #include <structs.hpp>
+#include <scheduler.hpp>
 #include <glm/glm.hpp>
 #include <spdlog/spdlog.h>
 
@@ -83,6 +87,99 @@ namespace Utils{
 		return min;
 	}
 
+	inline QuantizedData quantizeLayout(const std::vector<float>& data, const std::vector<glm::vec2>& ranges, const glm::vec2& to) {
+		/*
+		 * Low cardinality attributes get 8 bit, all others 16 bit. Rows are packed 
+		 * into 32 bit words, values never straddle a word since they are aligned 
+		 * to their own size.
+		 */
+		
+		QuantizedData result;
+		int num = ranges.size();
+		int offset = 0;
+		for (int j = 0; j < num; j++) {
+			std::unordered_set<float> distinct;
+			for (int i = j; i < data.size() && distinct.size() <= 256; i += num) {
+				distinct.insert(data[i]);
+			}
+			
+			unsigned int bits = distinct.size() <= 256 ? 8 : 16;
+			offset = (offset + bits - 1) / bits * bits;
+			float q_max = float((1u << bits) - 1);
+			result.attributes.push_back(QuantizedAttribute{
+				glm::vec2((to.y - to.x) / q_max, to.x), 
+				unsigned(offset),
+				bits
+			});
+			result.distinct.push_back(bits == 8 ? distinct : std::unordered_set<float>{});
+			offset += bits;
+		}
+		result.rowWords = (offset + 31) / 32;
+		return result;
+	}
+
+	inline bool extendLayout(QuantizedData& layout, const std::vector<float>& rows) {
+		// false once an 8 bit attribute has too many values, the layout has to be rebuilt then
+		int num = layout.attributes.size();
+		for (int j = 0; j < num; j++) {
+			if (layout.attributes[j].bits != 8) {
+				continue;
+			}
+			for (int i = j; i < rows.size(); i += num) {
+				layout.distinct[j].insert(rows[i]);
+			}
+			if (layout.distinct[j].size() > 256) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	inline std::vector<unsigned int> quantizeRows(const std::vector<float>& data, const std::vector<glm::vec2>& ranges, const QuantizedData& layout,
+		std::vector<double>* max_error = nullptr, std::vector<double>* squared_error = nullptr) {
+		// every value against the range of its attribute, errors in data units
+		int num = ranges.size();
+		int rows = data.size() / num;
+		std::vector<unsigned int> words(rows * layout.rowWords, 0);
+		for (int i = 0; i < rows; i++) {
+			for (int j = 0; j < num; j++) {
+				const auto& attribute = layout.attributes[j];
+				float q_max = float((1u << attribute.bits) - 1);
+				float extent = ranges[j].y - ranges[j].x;
+				float value = data[i * num + j];
+				
+				unsigned int q = extent > 0 ? unsigned(std::lround((value - ranges[j].x) / extent * q_max)) : 0;
+				words[i * layout.rowWords + attribute.bitOffset / 32] |= q << (attribute.bitOffset % 32);
+
+				if (max_error && squared_error) {
+					double error = std::abs(ranges[j].x + q / q_max * extent - value);
+					(*max_error)[j] = std::max((*max_error)[j], error);
+					(*squared_error)[j] += error * error;
+				}
+			}
+		}
+		return words;
+	}
+
+	inline QuantizedData quantizeData(const std::vector<float>& data, const std::vector<glm::vec2>& ranges, const glm::vec2& to) {
+		// layout and all rows, errors per attribute only at debug level
+		QuantizedData result = quantizeLayout(data, ranges, to);
+		int num = ranges.size();
+		int rows = data.size() / num;
+		std::vector<double> max_error(num, 0);
+		std::vector<double> squared_error(num, 0);
+		result.words = quantizeRows(data, ranges, result, &max_error, &squared_error);
+
+		for (int j = 0; j < num; j++) {
+			spdlog::debug("Attribute {} quantized to {} bit, max error {:.6f}, rms error {:.6f} (range {} - {})", 
+				j, result.attributes[j].bits, max_error[j], std::sqrt(squared_error[j] / std::max(rows, 1)), ranges[j].x, ranges[j].y);
+		}
+		spdlog::info("Quantized data {} bytes instead of {} bytes ({:.1f}%)", 
+			vectorsizeof(result.words), vectorsizeof(data), 100.0 * vectorsizeof(result.words) / std::max<size_t>(vectorsizeof(data), 1));
+		
+		return result;
+	}
+
 	inline glm::vec2 bezier(const float& u, const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3) {
 		float B0 = (1.0 - u) * (1.0 - u) * (1.0 - u);
 		float B1 = 3.0 * (1.0 - u) * (1.0 - u) * u;
@@ -109,13 +206,104 @@ namespace Utils{
 		return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
 	}
 	
+	inline Settings parseSettings(int argc, char** argv) {
+		/*
+		 * Reads command line options of the form '--name value',
+		 * unknown options are reported and ignored
+		 */
+
+		Settings settings;
+		for (int i = 1; i < argc; i++) {
+			std::string option = argv[i];
+			bool has_value = i + 1 < argc;
+			
+			if (option == "--quantize") {
+				settings.quantize = true;
+			}
+			else if (option == "--time-steps" && has_value) {
+				settings.timeSteps = std::max(std::stoi(argv[++i]), 1);
+			}
+			else if (option == "--visible-time-steps" && has_value) {
+				settings.visibleTimeSteps = std::stoi(argv[++i]);
+			}
+			else if (option == "--budget" && has_value) {
+				settings.frameBudgetMs = std::stof(argv[++i]);
+			}
+			else if (option == "--shader-cache" && has_value) {
+				settings.shaderCacheDir = argv[++i];
+			}
+			else if (option == "--check-allocations") {
+				settings.checkAllocations = true;
+			}
+			else if (option == "--gpu-budget" && has_value) {
+				settings.gpuBudgetMb = std::stof(argv[++i]);
+			}
+			else if (option == "--visible-axes" && has_value) {
+				settings.visibleAxes = std::stoi(argv[++i]);
+			}
+			else if (option == "--filter") {
+				settings.filter = true;
+			}
+			else if (option == "--data" && has_value) {
+				settings.dataPath = argv[++i];
+			}
+			else if (option == "--resident-mb" && has_value) {
+				settings.residentMb = std::stof(argv[++i]);
+			}
+			else if (option == "--preview-rows" && has_value) {
+				settings.previewRows = std::stoi(argv[++i]);
+			}
+			else if (option == "--strata" && has_value) {
+				settings.strataAttribute = std::stoi(argv[++i]);
+			}
+			else if (option == "--convert" && has_value) {
+				settings.convertPath = argv[++i];
+			}
+			else if (option == "--headless") {
+				settings.headless = true;
+			}
+			else if (option == "--record" && has_value) {
+				settings.recordPath = argv[++i];
+			}
+			else if (option == "--replay" && has_value) {
+				settings.replayPath = argv[++i];
+			}
+			else if (option == "--benchmark" && has_value) {
+				settings.benchmarkPath = argv[++i];
+			}
+			else if (option == "--update-baseline") {
+				settings.updateBaseline = true;
+			}
+			else if (option == "--allocation-test") {
+				settings.allocationTest = true;
+			}
+			else if (option == "--bench-scheduler") {
+				settings.benchScheduler = true;
+			}
+			else {
+				spdlog::warn("Ignoring unknown option '{}'", option);
+			}
+		}
+		return settings;
+	}
+
+	template<typename Func>
+	inline void parallelFor(const size_t& count, const Func& func) {
+		/*
+		 * Calls func for every index in [0, count) on the shared scheduler, 
+		 * with the priority of the calling task (interactive on the render thread)
+		 */
+		Scheduler::instance().parallelFor(count, func);
+	}
+
 	inline bool compare(const SortObj& a, const SortObj& b) { 
 		return a.val < b.val; 
 	} 
 
 	inline bool sortWithIndecies(const std::vector<float>& val, std::vector<int>& order) {
-		// create obj for linked sorting
-		std::vector<SortObj> tmp;
+		// create obj for linked sorting, scratch is kept so sorting doesn't allocate once warm
+		static thread_local std::vector<SortObj> tmp;
+		tmp.clear();
 		for (int i = 0; i < val.size(); i++) { 
 			tmp.push_back(SortObj{
 				val[i], 
@@ -126,16 +314,15 @@ namespace Utils{
 		// sort by value
 		std::sort(tmp.begin(), tmp.end(), compare);
 		
-		// write linked sorting results to input buffers
-		auto prv_val = val;
+		// write linked sorting results to input buffers, report if order changed
+		bool changed = false;
 		for (int i = 0; i < tmp.size(); i++) {
-			prv_val[i] = tmp[i].index;
-			order[i] = tmp[i].index;
+			if (order[i] != tmp[i].index) {
+				order[i] = tmp[i].index;
+				changed = true;
+			}
 		}
 		
-		if(val != prv_val)
-			return true;
-		
-		return false;
+		return changed;
 	}
 }
\ No newline at end of file